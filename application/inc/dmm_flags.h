@@ -15,10 +15,13 @@
 
 /*** Board options ***/
 
+#define DMM_RADIO_UL_PAYLOAD_COMPACT
+
 #ifdef DMM_NVM_FACTORY_RESET
 #define DMM_NODE_SCAN_PERIOD_SECONDS    86400
 #define DMM_SIGFOX_UL_PERIOD_SECONDS    300
 #define DMM_SIGFOX_DL_PERIOD_SECONDS    21600
+#define DMM_RADIO_AGGREGATION_PERIOD_SECONDS    60
 #endif
 
 #endif /* __DMM_FLAGS_H__ */
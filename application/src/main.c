@@ -16,6 +16,7 @@
 #include "pwr.h"
 #include "rcc.h"
 #include "rtc.h"
+#include "stm32l0xx_drivers_flags.h"
 // Utils.
 #include "types.h"
 // Components.
@@ -33,7 +34,10 @@
 
 /*** MAIN local macros ***/
 
-#define DMM_POWER_ON_DELAY_MS   2000
+#define DMM_POWER_ON_DELAY_MS           2000
+// Actions due before the next RTC wake-up are waited with the delay timer.
+// Nodes and HMI are not processed during the wait, which adds up to this duration of HMI latency.
+#define DMM_ACTION_WAIT_MAX_SECONDS     STM32L0XX_DRIVERS_RTC_WAKEUP_PERIOD_SECONDS
 
 /*** MAIN local functions ***/
 
@@ -105,6 +109,9 @@ int main(void) {
     NODE_status_t node_status = NODE_SUCCESS;
     HMI_status_t hmi_status = HMI_SUCCESS;
     RADIO_status_t radio_status = RADIO_SUCCESS;
+    uint32_t next_action_time_seconds = 0;
+    uint32_t uptime_seconds = 0;
+    uint8_t action_wait_flag = 0;
     // Power on delay to wait for slaves node startup.
     lptim_status = LPTIM_delay_milliseconds(DMM_POWER_ON_DELAY_MS, LPTIM_DELAY_MODE_STOP);
     LPTIM_stack_error(ERROR_BASE_LPTIM);
@@ -113,12 +120,27 @@ int main(void) {
     NODE_stack_error(ERROR_BASE_NODE);
     // Main loop.
     while (1) {
-        // Enter sleep mode.
         IWDG_reload();
+        // Wait for the next downlink action if it is due before the next wake-up.
+        radio_status = RADIO_get_next_action_time(&next_action_time_seconds);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+        uptime_seconds = RTC_get_uptime_seconds();
+        action_wait_flag = 0;
+        if ((next_action_time_seconds != RADIO_ACTION_TIME_NONE) && (next_action_time_seconds > uptime_seconds) && (next_action_time_seconds < (uptime_seconds + DMM_ACTION_WAIT_MAX_SECONDS))) {
+            lptim_status = LPTIM_delay_milliseconds(((next_action_time_seconds - uptime_seconds) * 1000), LPTIM_DELAY_MODE_STOP);
+            LPTIM_stack_error(ERROR_BASE_LPTIM);
+            IWDG_reload();
+            radio_status = RADIO_execute_actions(next_action_time_seconds);
+            RADIO_stack_error(ERROR_BASE_RADIO);
+            action_wait_flag = 1;
+        }
+        // Enter sleep mode (skipped after an action wait to process pending HMI events without waiting for the next RTC wake-up).
+        if (action_wait_flag == 0) {
 #ifndef DMM_DEBUG
-        PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP);
-        IWDG_reload();
+            PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP);
+            IWDG_reload();
 #endif
+        }
         // Process nodes.
         node_status = NODE_process();
         NODE_stack_error(ERROR_BASE_NODE);
@@ -15,6 +15,7 @@
 typedef enum {
     NVM_ADDRESS_UNA_SELF_ADDRESS = 0,
     NVM_ADDRESS_UNA_REGISTERS = 0x40,
+    NVM_ADDRESS_RADIO_QUEUE = 0x400,
 } NVM_address_mapping_t;
 
 #endif /* __NVM_ADDRESS_H__ */
@@ -28,6 +28,11 @@ typedef enum {
     HMI_DMM_LINE_INDEX_NODE_SCAN_PERIOD,
     HMI_DMM_LINE_INDEX_SIGFOX_UL_PERIOD,
     HMI_DMM_LINE_INDEX_SIGFOX_DL_PERIOD,
+    HMI_DMM_LINE_INDEX_BUS_TRANSACTION_COUNT,
+    HMI_DMM_LINE_INDEX_BUS_TIMEOUT_COUNT,
+    HMI_DMM_LINE_INDEX_BUS_UNHEALTHY_ACCESS_COUNT,
+    HMI_DMM_LINE_INDEX_BUS_BYTE_COUNT,
+    HMI_DMM_LINE_INDEX_BUS_TIME,
     HMI_DMM_LINE_INDEX_LAST,
 } HMI_DMM_line_index_t;
 
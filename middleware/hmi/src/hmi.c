@@ -119,6 +119,7 @@ typedef struct {
     SH1106_horizontal_line_t sh1106_line;
     // Current node.
     UNA_node_t node;
+    uint32_t node_list_generation;
 } HMI_context_t;
 
 /*** HMI local functions declaration ***/
@@ -171,7 +172,8 @@ static HMI_context_t hmi_ctx = {
     .node = {
         .address = UNA_NODE_ADDRESS_ERROR,
         .board_id = UNA_BOARD_ID_ERROR
-    }
+    },
+    .node_list_generation = 0
 };
 
 /*** HMI local functions ***/
@@ -450,6 +452,7 @@ static HMI_status_t _HMI_update_all_data(HMI_screen_t screen) {
             STRING_exit_error(HMI_ERROR_BASE_STRING);
         }
         hmi_ctx.data_depth = NODE_LIST.count;
+        hmi_ctx.node_list_generation = NODE_get_list_generation();
         break;
     case HMI_SCREEN_NODES_SCAN:
         // Common parameters.
@@ -698,6 +701,14 @@ static HMI_status_t _HMI_process_encoder_switch(void) {
     // Check current screen.
     switch (hmi_ctx.screen) {
     case HMI_SCREEN_NODE_LIST:
+        // Refresh displayed list if it has changed in the meantime.
+        if (hmi_ctx.node_list_generation != NODE_get_list_generation()) {
+            _HMI_reset_navigation();
+            status = _HMI_update_and_print_title(HMI_SCREEN_NODE_LIST);
+            if (status != HMI_SUCCESS) break;
+            status = _HMI_update(HMI_SCREEN_NODE_LIST, 1, 1);
+            break;
+        }
         // Update current node.
         hmi_ctx.node.address = NODE_LIST.list[hmi_ctx.data_index].address;
         hmi_ctx.node.board_id = NODE_LIST.list[hmi_ctx.data_index].board_id;
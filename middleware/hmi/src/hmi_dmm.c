@@ -11,6 +11,7 @@
 #include "dmm_registers.h"
 #include "hmi_common.h"
 #include "una.h"
+#include "una_dmm.h"
 
 /*** HMI DMM global variables ***/
 
@@ -22,5 +23,10 @@ const HMI_NODE_line_t HMI_DMM_LINE[HMI_DMM_LINE_INDEX_LAST] = {
     { "NODE_CNT =", HMI_NODE_DATA_TYPE_RAW_DECIMAL, DMM_REGISTER_ADDRESS_STATUS_1, DMM_REGISTER_STATUS_1_MASK_NODE_COUNT, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
     { "SC_PRD =", HMI_NODE_DATA_TYPE_TIME, DMM_REGISTER_ADDRESS_CONFIGURATION_0, DMM_REGISTER_CONFIGURATION_0_MASK_NODE_SCAN_PERIOD, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
     { "UL_PRD =", HMI_NODE_DATA_TYPE_TIME, DMM_REGISTER_ADDRESS_CONFIGURATION_0, DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_UL_PERIOD, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
-    { "DL_PRD =", HMI_NODE_DATA_TYPE_TIME, DMM_REGISTER_ADDRESS_CONFIGURATION_0, DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_DL_PERIOD, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE }
+    { "DL_PRD =", HMI_NODE_DATA_TYPE_TIME, DMM_REGISTER_ADDRESS_CONFIGURATION_0, DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_DL_PERIOD, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
+    { "BUS_TX =", HMI_NODE_DATA_TYPE_RAW_DECIMAL, UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_0, UNA_DMM_REGISTER_BUS_STATISTICS_0_MASK_TRANSACTION_COUNT, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
+    { "BUS_TO =", HMI_NODE_DATA_TYPE_RAW_DECIMAL, UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_1, UNA_DMM_REGISTER_BUS_STATISTICS_1_MASK_TIMEOUT_COUNT, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
+    { "BUS_UA =", HMI_NODE_DATA_TYPE_RAW_DECIMAL, UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_1, UNA_DMM_REGISTER_BUS_STATISTICS_1_MASK_UNHEALTHY_ACCESS_COUNT, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
+    { "BUS_B =", HMI_NODE_DATA_TYPE_RAW_DECIMAL, UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_2, UNA_DMM_REGISTER_BUS_STATISTICS_2_MASK_BYTE_COUNT, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE },
+    { "BUS_MS =", HMI_NODE_DATA_TYPE_RAW_DECIMAL, UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_3, UNA_DMM_REGISTER_BUS_STATISTICS_3_MASK_BUS_TIME, DMM_REGISTER_ADDRESS_CONTROL_1, UNA_REGISTER_MASK_NONE }
 };
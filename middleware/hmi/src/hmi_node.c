@@ -375,7 +375,12 @@ HMI_status_t HMI_NODE_read_line_all(UNA_node_t* node) {
     HMI_status_t status = HMI_SUCCESS;
     NODE_status_t node_status = NODE_SUCCESS;
     UNA_access_status_t write_status;
+    uint8_t session_opened = 0;
     uint8_t idx = 0;
+    // Open bus session.
+    node_status = NODE_open_session();
+    NODE_exit_error(HMI_ERROR_BASE_NODE);
+    session_opened = 1;
     // Check board ID.
     _HMI_NODE_check_node();
     // Reset buffers.
@@ -394,6 +399,10 @@ HMI_status_t HMI_NODE_read_line_all(UNA_node_t* node) {
         if (status != HMI_SUCCESS) goto errors;
     }
 errors:
+    // Close bus session.
+    if (session_opened != 0) {
+        NODE_close_session();
+    }
     return status;
 }
 
@@ -20,7 +20,9 @@
 
 /*** NODES macros ***/
 
-#define NODE_LIST_SIZE  32
+#define NODE_LIST_SIZE                          32
+
+#define NODE_STATISTICS_LATENCY_BIN_COUNT       4
 
 /*** NODE structures ***/
 
@@ -36,6 +38,9 @@ typedef enum {
     NODE_ERROR_PROTOCOL,
     NODE_ERROR_REGISTER_ADDRESS_LIST_SIZE,
     NODE_ERROR_SCAN_PERIOD_READ,
+    NODE_ERROR_SESSION_STATE,
+    NODE_ERROR_NODE_ADDRESS,
+    NODE_ERROR_RS485_BUS_VOLTAGE,
     // Low level drivers errors.
     NODE_ERROR_BASE_ACCESS_STATUS_CODE = ERROR_BASE_STEP,
     NODE_ERROR_BASE_ACCESS_STATUS_ADDRESS = (NODE_ERROR_BASE_ACCESS_STATUS_CODE + ERROR_BASE_STEP),
@@ -49,6 +54,30 @@ typedef enum {
     NODE_ERROR_BASE_LAST = (NODE_ERROR_BASE_UNA_R4S8CR + UNA_R4S8CR_ERROR_BASE_LAST),
 } NODE_status_t;
 
+/*!******************************************************************
+ * \enum NODE_health_t
+ * \brief Node health states.
+ *******************************************************************/
+typedef enum {
+    NODE_HEALTH_HEALTHY = 0,
+    NODE_HEALTH_SUSPECT,
+    NODE_HEALTH_QUARANTINED,
+    NODE_HEALTH_LAST
+} NODE_health_t;
+
+/*!******************************************************************
+ * \struct NODE_statistics_t
+ * \brief Node bus transactions statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t transaction_count;
+    uint32_t timeout_count;
+    uint32_t unhealthy_access_count;
+    uint32_t byte_count;
+    uint32_t bus_time_ms;
+    uint32_t latency_histogram[NODE_STATISTICS_LATENCY_BIN_COUNT];
+} NODE_statistics_t;
+
 /*** NODES global variables ***/
 
 extern UNA_node_list_t NODE_LIST;
@@ -75,13 +104,113 @@ NODE_status_t NODE_de_init(void);
 
 /*!******************************************************************
  * \fn NODE_status_t NODE_process(void)
- * \brief Main task of node interface.
+ * \brief Main task of node interface (performs the periodic incremental scan, spread over several calls).
  * \param[in]   none
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
 NODE_status_t NODE_process(void);
 
+/*!******************************************************************
+ * \fn NODE_status_t NODE_open_session(void)
+ * \brief Open a bus session: the lower layer interface is kept configured between consecutive node accesses until the session is closed.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_open_session(void);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_close_session(void)
+ * \brief Close a bus session and release the lower layer interface if it was the outer one.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_close_session(void);
+
+/*!******************************************************************
+ * \fn uint32_t NODE_get_bus_reconfiguration_count(void)
+ * \brief Get the number of lower layer interface configurations performed during the current (or last) session.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Number of interface configurations.
+ *******************************************************************/
+uint32_t NODE_get_bus_reconfiguration_count(void);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_get_cache_statistics(uint32_t* hit_count, uint32_t* miss_count)
+ * \brief Get the register cache statistics.
+ * \param[in]   none
+ * \param[out]  hit_count: Pointer to the number of register reads served by the cache.
+ * \param[out]  miss_count: Pointer to the number of cacheable register reads which required a bus access.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_get_cache_statistics(uint32_t* hit_count, uint32_t* miss_count);
+
+/*!******************************************************************
+ * \fn void NODE_update_bus_wait_time(uint32_t delay_ms)
+ * \brief Account time spent waiting for a node reply (called by the UNA AT hardware interface).
+ * \param[in]   delay_ms: Delay performed in ms.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void NODE_update_bus_wait_time(uint32_t delay_ms);
+
+/*!******************************************************************
+ * \fn uint32_t NODE_get_bus_wait_time_ms(void)
+ * \brief Get the total time spent waiting for node replies since start-up.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Cumulated reply waiting time in ms.
+ *******************************************************************/
+uint32_t NODE_get_bus_wait_time_ms(void);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_get_statistics(UNA_node_address_t node_addr, NODE_statistics_t* statistics)
+ * \brief Get the bus transactions statistics of a node.
+ * \param[in]   node_addr: Address of the node (master address to get the whole bus statistics).
+ * \param[out]  statistics: Pointer to the node statistics.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_get_statistics(UNA_node_address_t node_addr, NODE_statistics_t* statistics);
+
+/*!******************************************************************
+ * \fn uint32_t NODE_get_list_generation(void)
+ * \brief Get the node list generation, which is incremented each time the list is modified.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Current node list generation.
+ *******************************************************************/
+uint32_t NODE_get_list_generation(void);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_get_list_index(UNA_node_address_t node_addr, uint8_t* list_index)
+ * \brief Get the index of a node in the node list.
+ * \param[in]   node_addr: Address of the node to search.
+ * \param[out]  list_index: Pointer to the index of the node in NODE_LIST.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_get_list_index(UNA_node_address_t node_addr, uint8_t* list_index);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_get_board_list_index(uint8_t board_id, uint8_t* list_index)
+ * \brief Get the index of the first node of a given board ID in the node list.
+ * \param[in]   board_id: Board ID to search.
+ * \param[out]  list_index: Pointer to the index of the node in NODE_LIST.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_get_board_list_index(uint8_t board_id, uint8_t* list_index);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_get_health(UNA_node_address_t node_addr, NODE_health_t* health)
+ * \brief Get the health state of a node.
+ * \param[in]   node_addr: Address of the node.
+ * \param[out]  health: Pointer to the node health state.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_get_health(UNA_node_address_t node_addr, NODE_health_t* health);
+
 /*!******************************************************************
  * \fn NODE_status_t NODE_write_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_access_status_t* write_status)
  * \brief Write node register.
@@ -94,9 +223,35 @@ NODE_status_t NODE_process(void);
  *******************************************************************/
 NODE_status_t NODE_write_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_access_status_t* write_status);
 
+/*!******************************************************************
+ * \fn NODE_status_t NODE_send_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_access_status_t* write_status)
+ * \brief Write node register without waiting for the reply (used to start long operations).
+ * \param[in]   node: Pointer to the node to access.
+ * \param[in]   reg_addr: Address of the register to write.
+ * \param[in]   reg_value: Register value to write.
+ * \param[in]   reg_mask: Writing operation mask.
+ * \param[out]  write_status: Pointer to the writing operation status.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_send_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_access_status_t* write_status);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_write_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint32_t* reg_value_list, uint32_t* reg_mask_list, uint8_t reg_list_size, UNA_access_status_t* write_status, uint8_t* write_count)
+ * \brief Write a list of node registers in order within a single bus session.
+ * \param[in]   node: Pointer to the node to access.
+ * \param[in]   reg_addr_list: List of the addresses of the registers to write.
+ * \param[in]   reg_value_list: List of the values to write (indexed as reg_addr_list).
+ * \param[in]   reg_mask_list: List of the writing operation masks (indexed as reg_addr_list).
+ * \param[in]   reg_list_size: Number of registers to write.
+ * \param[out]  write_status: Pointer to the writing operation status, which is the one of the first failed access if any.
+ * \param[out]  write_count: Pointer to the number of registers successfully written (the sequence stops on first failure).
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_write_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint32_t* reg_value_list, uint32_t* reg_mask_list, uint8_t reg_list_size, UNA_access_status_t* write_status, uint8_t* write_count);
+
 /*!******************************************************************
  * \fn NODE_status_t NODE_perform_measurements(UNA_node_t* node, UNA_access_status_t* write_status)
- * \brief Send the command to perform all node measurements.
+ * \brief Send the command to perform all node measurements (UNA AT nodes answer once their conversions are completed, so the measurements of several nodes can not overlap on the bus).
  * \param[in]   node: Pointer to the node to access.
  * \param[out]  write_status: Pointer to the writing operation status.
  * \retval      Function execution status.
@@ -115,20 +270,32 @@ NODE_status_t NODE_perform_measurements(UNA_node_t* node, UNA_access_status_t* w
 NODE_status_t NODE_read_register(UNA_node_t* node, uint8_t reg_addr, uint32_t* reg_value, UNA_access_status_t* read_status);
 
 /*!******************************************************************
- * \fn NODE_status_t NODE_read_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint8_t reg_addr_list_size, uint32_t* node_registers, UNA_access_status_t* read_status)
- * \brief Read node registers.
+ * \fn NODE_status_t NODE_read_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint8_t reg_addr_list_size, uint32_t* node_registers, UNA_access_status_t* read_status_list, UNA_access_status_t* read_status)
+ * \brief Read a list of node registers within a single bus session.
  * \param[in]   node: Pointer to the node to access.
  * \param[in]   reg_addr_list: List of the addresses of the registers to read.
  * \param[in]   reg_addr_list_size: Number of registers to read.
- * \param[out]  node_registers: Pointer to the node registers value.
- * \param[out]  read_status: Pointer to the read operation status.
+ * \param[out]  node_registers: Pointer to the node registers value. Registers which could not be read are set to their error value.
+ * \param[out]  read_status_list: Optional pointer to the read status of each register (indexed as reg_addr_list), can be NULL.
+ * \param[out]  read_status: Pointer to the global read status, which is only failed when none of the registers could be read.
+ * \retval      Function execution status.
+ *******************************************************************/
+NODE_status_t NODE_read_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint8_t reg_addr_list_size, uint32_t* node_registers, UNA_access_status_t* read_status_list, UNA_access_status_t* read_status);
+
+/*!******************************************************************
+ * \fn NODE_status_t NODE_poll_register(UNA_node_t* node, uint8_t reg_addr, uint32_t* reg_value, UNA_access_status_t* read_status)
+ * \brief Read a register of a node which may be busy (pending received bytes are flushed), without affecting its link statistics and health.
+ * \param[in]   node: Pointer to the node to access.
+ * \param[in]   reg_addr: Address of the register to read.
+ * \param[out]  reg_value: Pointer to the read value.
+ * \param[out]  read_status: Pointer to the read operation status (reply timeout while the node is busy).
  * \retval      Function execution status.
  *******************************************************************/
-NODE_status_t NODE_read_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint8_t reg_addr_list_size, uint32_t* node_registers, UNA_access_status_t* read_status);
+NODE_status_t NODE_poll_register(UNA_node_t* node, uint8_t reg_addr, uint32_t* reg_value, UNA_access_status_t* read_status);
 
 /*!******************************************************************
  * \fn NODE_status_t NODE_scan(void)
- * \brief Scan all nodes connected to the RS485 bus.
+ * \brief Perform a full scan of all nodes connected to the RS485 bus.
  * \param[in]   none
  * \param[out]  none
  * \retval      Function execution status.
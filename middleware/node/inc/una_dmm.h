@@ -8,11 +8,65 @@
 #ifndef __UNA_DMM_H__
 #define __UNA_DMM_H__
 
+#include "dmm_registers.h"
 #include "error.h"
 #include "nvm.h"
 #include "types.h"
 #include "una.h"
 
+/*** DMM macros ***/
+
+#define UNA_DMM_RADIO_NODE_SLOT_COUNT                                   4
+#define UNA_DMM_RADIO_NODE_PATTERN_SIZE_MAX                             16
+#define UNA_DMM_RADIO_NODE_PATTERN_ENTRY_SIZE_BITS                      2
+
+// Default Sigfox daily messages budget (0 disables the uplink budget).
+#define UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT                       0
+#define UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT                       4
+
+#define UNA_DMM_REGISTER_BUS_STATISTICS_CONFIGURATION_MASK_NODE_ADDR    0x000000FF
+
+#define UNA_DMM_REGISTER_BUS_STATISTICS_0_MASK_TRANSACTION_COUNT        0xFFFFFFFF
+
+#define UNA_DMM_REGISTER_BUS_STATISTICS_1_MASK_TIMEOUT_COUNT            0x0000FFFF
+#define UNA_DMM_REGISTER_BUS_STATISTICS_1_MASK_UNHEALTHY_ACCESS_COUNT    0xFFFF0000
+
+#define UNA_DMM_REGISTER_BUS_STATISTICS_2_MASK_BYTE_COUNT               0xFFFFFFFF
+
+#define UNA_DMM_REGISTER_BUS_STATISTICS_3_MASK_BUS_TIME                 0xFFFFFFFF
+
+#define UNA_DMM_REGISTER_BUS_STATISTICS_4_MASK_LATENCY_BIN_0            0x0000FFFF
+#define UNA_DMM_REGISTER_BUS_STATISTICS_4_MASK_LATENCY_BIN_1            0xFFFF0000
+
+#define UNA_DMM_REGISTER_BUS_STATISTICS_5_MASK_LATENCY_BIN_2            0x0000FFFF
+#define UNA_DMM_REGISTER_BUS_STATISTICS_5_MASK_LATENCY_BIN_3            0xFFFF0000
+
+#define UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_UL_MESSAGES    0x0000FFFF
+#define UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_DL_MESSAGES    0x00FF0000
+
+#define UNA_DMM_REGISTER_RADIO_BUDGET_STATUS_0_MASK_UL_COUNT            0x0000FFFF
+#define UNA_DMM_REGISTER_RADIO_BUDGET_STATUS_0_MASK_DL_COUNT            0x00FF0000
+
+#define UNA_DMM_REGISTER_RADIO_BUDGET_STATUS_1_MASK_UL_PERIOD           0xFFFFFFFF
+
+#define UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_NODE_ADDR        0x000000FF
+#define UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_UL_PERIOD        0x0000FF00
+#define UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_PATTERN_SIZE     0x001F0000
+
+#define UNA_DMM_REGISTER_RADIO_NODE_PATTERN_MASK_PATTERN                0xFFFFFFFF
+
+#define UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_VOLTAGE_ABSOLUTE         0x0000FFFF
+#define UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_VOLTAGE_RELATIVE         0x00FF0000
+#define UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_HEARTBEAT_PERIOD         0xFF000000
+
+#define UNA_DMM_REGISTER_RADIO_DEADBAND_1_MASK_CURRENT_ABSOLUTE         0x0000FFFF
+#define UNA_DMM_REGISTER_RADIO_DEADBAND_1_MASK_CURRENT_RELATIVE         0x00FF0000
+
+#define UNA_DMM_REGISTER_RADIO_DEADBAND_2_MASK_TEMPERATURE_ABSOLUTE     0x0000FFFF
+#define UNA_DMM_REGISTER_RADIO_DEADBAND_2_MASK_TEMPERATURE_RELATIVE     0x00FF0000
+
+#define UNA_DMM_REGISTER_RADIO_AGGREGATION_CONFIGURATION_MASK_SAMPLING_PERIOD   0x000000FF
+
 /*** DMM structures ***/
 
 typedef enum {
@@ -26,6 +80,40 @@ typedef enum {
     UNA_DMM_ERROR_BASE_LAST = (UNA_DMM_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
 } UNA_DMM_status_t;
 
+/*!******************************************************************
+ * \enum UNA_DMM_register_address_t
+ * \brief DMM registers map extension (local registers which are not part of the common DMM registers map).
+ *******************************************************************/
+typedef enum {
+    UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_CONFIGURATION = DMM_REGISTER_ADDRESS_LAST,
+    UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_0,
+    UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_1,
+    UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_2,
+    UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_3,
+    UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_4,
+    UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_5,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_CONFIGURATION,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_STATUS_0,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_STATUS_1,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_0_CONFIGURATION,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_0_PATTERN,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_1_CONFIGURATION,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_1_PATTERN,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_2_CONFIGURATION,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_2_PATTERN,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_3_CONFIGURATION,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_3_PATTERN,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_0,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_1,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_2,
+    UNA_DMM_REGISTER_ADDRESS_RADIO_AGGREGATION_CONFIGURATION,
+    UNA_DMM_REGISTER_ADDRESS_LAST
+} UNA_DMM_register_address_t;
+
+/*** DMM global variables ***/
+
+extern UNA_register_t UNA_DMM_REGISTER[UNA_DMM_REGISTER_ADDRESS_LAST];
+
 /*** DMM functions ***/
 
 /*!******************************************************************
@@ -58,6 +146,17 @@ UNA_DMM_status_t UNA_DMM_write_register(UNA_access_parameters_t* write_params, u
  *******************************************************************/
 UNA_DMM_status_t UNA_DMM_read_register(UNA_access_parameters_t* read_params, uint32_t* reg_value, UNA_access_status_t* read_status);
 
+/*!******************************************************************
+ * \fn void UNA_DMM_set_radio_budget_status(uint32_t ul_message_count, uint32_t dl_message_count, uint32_t ul_effective_period_seconds)
+ * \brief Update radio messages budget status registers.
+ * \param[in]   ul_message_count: Number of uplink messages sent over the last 24 hours.
+ * \param[in]   dl_message_count: Number of downlink messages received over the last 24 hours.
+ * \param[in]   ul_effective_period_seconds: Effective uplink period in seconds.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void UNA_DMM_set_radio_budget_status(uint32_t ul_message_count, uint32_t dl_message_count, uint32_t ul_effective_period_seconds);
+
 /*******************************************************************/
 #define UNA_DMM_exit_error(base) { ERROR_check_exit(una_dmm_status, UNA_DMM_SUCCESS, base) }
 
@@ -28,15 +28,48 @@
 #include "uhfm_registers.h"
 #include "una.h"
 #include "una_at.h"
+#ifndef UNA_AT_DISABLE_FLAGS_FILE
+#include "una_at_flags.h"
+#endif
 #include "una_dmm.h"
 #include "una_r4s8cr.h"
 
 /*** NODE local macros ***/
 
 #define NODE_LIST_DMM_NODE_INDEX            0
-#define NODE_UNA_AT_BAUD_RATE               1200
+#define NODE_UNA_AT_BAUD_RATE_FAILURE_MAX   3
+
+#define NODE_HEALTH_QUARANTINE_THRESHOLD    3
+#define NODE_HEALTH_BACKOFF_MIN_SECONDS     60
+#define NODE_HEALTH_BACKOFF_MAX_SECONDS     86400
+#define NODE_HEALTH_BACKOFF_EXPONENT_MAX    11
+
+// Below this value, the RS485 bus is considered browned out and no transaction is performed.
+#define NODE_RS485_BUS_VOLTAGE_MIN_MV       3000
+
+#define NODE_RTT_SAMPLE_COUNT_MIN           4
+#define NODE_RTT_CLASS_SLOW_THRESHOLD_MS    1000
+#define NODE_RTT_TIMEOUT_MIN_MS             50
+#define NODE_RTT_TIMEOUT_MARGIN_MS          20
 
 #define NODE_SCAN_PERIOD_DEFAULT_SECONDS    86400
+// UNA AT address range swept by the incremental scan (R4S8CR nodes are scanned separately).
+#define NODE_SCAN_UNA_AT_ADDRESS_FIRST      (UNA_NODE_ADDRESS_MASTER + 1)
+#define NODE_SCAN_UNA_AT_ADDRESS_LAST       (UNA_NODE_ADDRESS_R4S8CR_START - 1)
+#define NODE_SCAN_SLICE_SIZE                4
+// Number of consecutive scans without reply before a known node is removed from the list.
+#define NODE_SCAN_MISS_COUNT_MAX            3
+
+#define NODE_REGISTRY_ADDRESS_RANGE         256
+
+#define NODE_CACHE_SIZE                     64
+#define NODE_CACHE_TTL_SECONDS              3600
+
+// Estimated frame sizes used for bus statistics.
+#define NODE_UNA_AT_REQUEST_SIZE_BYTES      28
+#define NODE_UNA_AT_REPLY_SIZE_BYTES        12
+#define NODE_UNA_R4S8CR_REQUEST_SIZE_BYTES  4
+#define NODE_UNA_R4S8CR_REPLY_SIZE_BYTES    4
 
 /*** NODE local structures ***/
 
@@ -55,9 +88,102 @@ typedef struct {
     UNA_register_t* register_table;
 } NODE_descriptor_t;
 
+/*******************************************************************/
+typedef enum {
+    NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT = 0,
+    NODE_UNA_AT_BAUD_RATE_INDEX_HIGH,
+    NODE_UNA_AT_BAUD_RATE_INDEX_LAST
+} NODE_una_at_baud_rate_index_t;
+
+/*******************************************************************/
+typedef enum {
+    NODE_RTT_CLASS_FAST = 0,
+    NODE_RTT_CLASS_SLOW,
+    NODE_RTT_CLASS_LAST
+} NODE_rtt_class_t;
+
+/*******************************************************************/
+typedef struct {
+    uint32_t ewma_ms;
+    uint32_t max_ms;
+    uint8_t sample_count;
+} NODE_rtt_t;
+
+/*******************************************************************/
+typedef struct {
+    NODE_una_at_baud_rate_index_t baud_rate_index;
+    uint8_t failure_count;
+    NODE_rtt_t rtt[NODE_RTT_CLASS_LAST];
+    uint8_t scan_miss_count;
+    NODE_health_t health;
+    uint8_t health_failure_count;
+    uint8_t health_backoff_exponent;
+    uint32_t health_probe_time_seconds;
+    NODE_statistics_t statistics;
+} NODE_link_t;
+
+/*******************************************************************/
+typedef enum {
+    NODE_SCAN_STATE_IDLE = 0,
+    NODE_SCAN_STATE_SWEEP,
+    NODE_SCAN_STATE_LAST
+} NODE_scan_state_t;
+
+/*******************************************************************/
+typedef struct {
+    uint8_t list_index[NODE_REGISTRY_ADDRESS_RANGE];
+    uint8_t board_list_index[UNA_BOARD_ID_LAST];
+    uint8_t low_baud_rate[NODE_REGISTRY_ADDRESS_RANGE >> 3];
+    uint32_t generation;
+} NODE_registry_t;
+
+/*******************************************************************/
+typedef enum {
+    NODE_CACHE_POLICY_VOLATILE = 0,
+    NODE_CACHE_POLICY_STATIC,
+    NODE_CACHE_POLICY_TTL,
+    NODE_CACHE_POLICY_LAST
+} NODE_cache_policy_t;
+
+/*******************************************************************/
+typedef struct {
+    UNA_node_address_t address;
+    uint8_t reg_addr;
+    uint8_t valid;
+    uint32_t reg_value;
+    uint32_t timestamp_seconds;
+} NODE_cache_entry_t;
+
+/*******************************************************************/
+typedef struct {
+    NODE_cache_entry_t entry[NODE_CACHE_SIZE];
+    uint32_t hit_count;
+    uint32_t miss_count;
+} NODE_cache_t;
+
+/*******************************************************************/
+typedef struct {
+    uint8_t depth;
+    NODE_protocol_t protocol;
+    NODE_una_at_baud_rate_index_t baud_rate_index;
+    uint8_t bus_voltage_checked;
+    uint32_t reconfiguration_count;
+    uint32_t last_reconfiguration_count;
+} NODE_session_t;
+
 /*******************************************************************/
 typedef struct {
     uint32_t scan_next_time_seconds;
+    NODE_scan_state_t scan_state;
+    UNA_node_address_t scan_address;
+    NODE_link_t link[NODE_LIST_SIZE];
+    NODE_registry_t registry;
+    uint32_t reply_wait_ms;
+    uint32_t bus_wait_time_ms;
+    uint8_t bus_voltage_low;
+    NODE_statistics_t statistics;
+    NODE_session_t session;
+    NODE_cache_t cache;
 } NODE_context_t;
 
 /*** NODE global variables ***/
@@ -75,14 +201,31 @@ static const NODE_descriptor_t NODES[UNA_BOARD_ID_LAST] = {
     { NODE_PROTOCOL_UNA_AT, SM_REGISTER_ADDRESS_LAST, (UNA_register_t*) SM_REGISTER },
     { NODE_PROTOCOL_UNA_AT, 0, NULL },
     { NODE_PROTOCOL_UNA_AT, RRM_REGISTER_ADDRESS_LAST, (UNA_register_t*) RRM_REGISTER },
-    { NODE_PROTOCOL_UNA_DMM, DMM_REGISTER_ADDRESS_LAST, (UNA_register_t*) DMM_REGISTER },
+    { NODE_PROTOCOL_UNA_DMM, UNA_DMM_REGISTER_ADDRESS_LAST, (UNA_register_t*) UNA_DMM_REGISTER },
     { NODE_PROTOCOL_UNA_AT, MPMCM_REGISTER_ADDRESS_LAST, (UNA_register_t*) MPMCM_REGISTER },
     { NODE_PROTOCOL_UNA_R4S8CR, R4S8CR_REGISTER_ADDRESS_LAST, (UNA_register_t*) R4S8CR_REGISTER },
     { NODE_PROTOCOL_UNA_AT, BCM_REGISTER_ADDRESS_LAST, (UNA_register_t*) BCM_REGISTER },
 };
 
+static const uint32_t NODE_UNA_AT_BAUD_RATE[NODE_UNA_AT_BAUD_RATE_INDEX_LAST] = { 1200, 9600 };
+static const uint32_t NODE_STATISTICS_LATENCY_BIN_THRESHOLD_MS[NODE_STATISTICS_LATENCY_BIN_COUNT - 1] = { 50, 200, 1000 };
+
 static NODE_context_t node_ctx = {
-    .scan_next_time_seconds = 0
+    .scan_next_time_seconds = 0,
+    .scan_state = NODE_SCAN_STATE_IDLE,
+    .scan_address = NODE_SCAN_UNA_AT_ADDRESS_FIRST,
+    .registry.generation = 0,
+    .reply_wait_ms = 0,
+    .bus_wait_time_ms = 0,
+    .bus_voltage_low = 0,
+    .session.depth = 0,
+    .session.protocol = NODE_PROTOCOL_LAST,
+    .session.baud_rate_index = NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT,
+    .session.bus_voltage_checked = 0,
+    .session.reconfiguration_count = 0,
+    .session.last_reconfiguration_count = 0,
+    .cache.hit_count = 0,
+    .cache.miss_count = 0
 };
 
 /*** NODE local functions ***/
@@ -103,42 +246,830 @@ static NODE_context_t node_ctx = {
     } \
 }
 
-/*** NODE functions ***/
+/*******************************************************************/
+static NODE_status_t _NODE_release_protocol(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
+    UNA_R4S8CR_status_t una_r4s8cr_status = UNA_R4S8CR_SUCCESS;
+    // Check current protocol.
+    switch (node_ctx.session.protocol) {
+    case NODE_PROTOCOL_UNA_AT:
+        una_at_status = UNA_AT_de_init();
+        UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
+        break;
+    case NODE_PROTOCOL_UNA_R4S8CR:
+        una_r4s8cr_status = UNA_R4S8CR_de_init();
+        UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
+        break;
+    default:
+        // Nothing to do.
+        break;
+    }
+errors:
+    // Interface is considered released whatever the result.
+    node_ctx.session.protocol = NODE_PROTOCOL_LAST;
+    return status;
+}
 
 /*******************************************************************/
-NODE_status_t NODE_init(void) {
+static NODE_status_t _NODE_select_protocol(NODE_protocol_t protocol, NODE_una_at_baud_rate_index_t baud_rate_index) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
+    UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
+    UNA_R4S8CR_status_t una_r4s8cr_status = UNA_R4S8CR_SUCCESS;
+    UNA_AT_configuration_t una_at_config;
+    // Check parameter.
+    if (baud_rate_index >= NODE_UNA_AT_BAUD_RATE_INDEX_LAST) {
+        baud_rate_index = NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT;
+    }
+    // Directly exit if the interface is already configured.
+    if ((node_ctx.session.protocol == protocol) && ((protocol != NODE_PROTOCOL_UNA_AT) || (node_ctx.session.baud_rate_index == baud_rate_index))) goto errors;
+    // Release current interface.
+    status = _NODE_release_protocol();
+    if (status != NODE_SUCCESS) goto errors;
+    // Init new interface.
+    switch (protocol) {
+    case NODE_PROTOCOL_UNA_AT:
+        una_at_config.baud_rate = NODE_UNA_AT_BAUD_RATE[baud_rate_index];
+        una_at_status = UNA_AT_init(&una_at_config);
+        UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
+        break;
+    case NODE_PROTOCOL_UNA_R4S8CR:
+        una_r4s8cr_status = UNA_R4S8CR_init();
+        UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
+        break;
+    default:
+        status = NODE_ERROR_PROTOCOL;
+        goto errors;
+    }
+    // Update context.
+    node_ctx.session.protocol = protocol;
+    node_ctx.session.baud_rate_index = baud_rate_index;
+    node_ctx.session.reconfiguration_count++;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _NODE_end_access(void) {
+    // Release interface if the access was not part of a session.
+    if (node_ctx.session.depth == 0) {
+        _NODE_release_protocol();
+        node_ctx.session.bus_voltage_checked = 0;
+    }
+}
+
+/*******************************************************************/
+static NODE_cache_policy_t _NODE_get_cache_policy(UNA_node_t* node, uint8_t reg_addr) {
+    // Local variables.
+    NODE_cache_policy_t policy = NODE_CACHE_POLICY_VOLATILE;
+    // Local registers are directly accessed.
+    if (NODES[node->board_id].protocol == NODE_PROTOCOL_UNA_DMM) goto errors;
+    // Identification registers never change while the node is connected.
+    switch (reg_addr) {
+    case COMMON_REGISTER_ADDRESS_NODE_ID:
+    case COMMON_REGISTER_ADDRESS_HW_VERSION:
+    case COMMON_REGISTER_ADDRESS_SW_VERSION_0:
+    case COMMON_REGISTER_ADDRESS_SW_VERSION_1:
+    case COMMON_REGISTER_ADDRESS_FLAGS_0:
+        policy = NODE_CACHE_POLICY_STATIC;
+        break;
+    default:
+        // Configuration registers stored in node NVM only change on write.
+        if (NODES[node->board_id].register_table[reg_addr].reset_value == UNA_REGISTER_RESET_VALUE_NVM) {
+            policy = NODE_CACHE_POLICY_TTL;
+        }
+        break;
+    }
+errors:
+    return policy;
+}
+
+/*******************************************************************/
+static NODE_cache_entry_t* _NODE_cache_search(UNA_node_address_t address, uint8_t reg_addr) {
+    // Local variables.
+    NODE_cache_entry_t* entry = NULL;
+    uint8_t idx = 0;
+    // Entries loop.
+    for (idx = 0; idx < NODE_CACHE_SIZE; idx++) {
+        if ((node_ctx.cache.entry[idx].valid != 0) && (node_ctx.cache.entry[idx].address == address) && (node_ctx.cache.entry[idx].reg_addr == reg_addr)) {
+            entry = &(node_ctx.cache.entry[idx]);
+            break;
+        }
+    }
+    return entry;
+}
+
+/*******************************************************************/
+static void _NODE_cache_store(UNA_node_address_t address, uint8_t reg_addr, uint32_t reg_value) {
+    // Local variables.
+    NODE_cache_entry_t* entry = _NODE_cache_search(address, reg_addr);
+    uint8_t idx = 0;
+    // Allocate entry if needed.
+    if (entry == NULL) {
+        // Use first free entry or oldest one.
+        entry = &(node_ctx.cache.entry[0]);
+        for (idx = 0; idx < NODE_CACHE_SIZE; idx++) {
+            if (node_ctx.cache.entry[idx].valid == 0) {
+                entry = &(node_ctx.cache.entry[idx]);
+                break;
+            }
+            if (node_ctx.cache.entry[idx].timestamp_seconds < (entry->timestamp_seconds)) {
+                entry = &(node_ctx.cache.entry[idx]);
+            }
+        }
+    }
+    // Update entry.
+    entry->address = address;
+    entry->reg_addr = reg_addr;
+    entry->reg_value = reg_value;
+    entry->timestamp_seconds = RTC_get_uptime_seconds();
+    entry->valid = 1;
+}
+
+/*******************************************************************/
+static void _NODE_cache_invalidate(UNA_node_address_t address, uint8_t all_nodes) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Entries loop.
+    for (idx = 0; idx < NODE_CACHE_SIZE; idx++) {
+        if ((all_nodes != 0) || (node_ctx.cache.entry[idx].address == address)) {
+            node_ctx.cache.entry[idx].valid = 0;
+        }
+    }
+}
+
+/*******************************************************************/
+static void _NODE_cache_invalidate_write(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_mask) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Measurements trigger does not modify any cached register.
+    if ((reg_addr == COMMON_REGISTER_ADDRESS_CONTROL_0) && ((reg_mask & (~COMMON_REGISTER_CONTROL_0_MASK_MTRG)) == 0)) goto errors;
+    // Entries loop.
+    for (idx = 0; idx < NODE_CACHE_SIZE; idx++) {
+        if ((node_ctx.cache.entry[idx].valid == 0) || (node_ctx.cache.entry[idx].address != (node->address))) continue;
+        // Flush written register.
+        if (node_ctx.cache.entry[idx].reg_addr == reg_addr) {
+            node_ctx.cache.entry[idx].valid = 0;
+        }
+        // Other control actions (reset, flash) may reload the node configuration, but never change its identification.
+        if ((reg_addr == COMMON_REGISTER_ADDRESS_CONTROL_0) && (_NODE_get_cache_policy(node, node_ctx.cache.entry[idx].reg_addr) == NODE_CACHE_POLICY_TTL)) {
+            node_ctx.cache.entry[idx].valid = 0;
+        }
+    }
+errors:
+    return;
+}
+
+/*******************************************************************/
+static void _NODE_update_scan_next_time(void) {
+    // Local variables.
     UNA_DMM_status_t una_dmm_status = UNA_DMM_SUCCESS;
-    // Init context.
-    node_ctx.scan_next_time_seconds = 0;
-    // Reset node list.
-    UNA_reset_node_list(&NODE_LIST);
-    // Init self registers.
-    una_dmm_status = UNA_DMM_init();
-    UNA_DMM_exit_error(NODE_ERROR_BASE_UNA_DMM);
+    UNA_access_parameters_t read_params;
+    UNA_access_status_t read_status;
+    uint32_t reg_value = 0;
+    uint32_t scan_period_seconds = NODE_SCAN_PERIOD_DEFAULT_SECONDS;
+    // Read scan period.
+    read_params.node_addr = UNA_NODE_ADDRESS_MASTER;
+    read_params.reg_addr = DMM_REGISTER_ADDRESS_CONFIGURATION_0;
+    read_params.reply_params.type = UNA_REPLY_TYPE_OK;
+    read_params.reply_params.timeout_ms = 0;
+    una_dmm_status = UNA_DMM_read_register(&read_params, &reg_value, &read_status);
+    UNA_DMM_stack_error(ERROR_BASE_NODE + NODE_ERROR_BASE_UNA_DMM);
+    // Check access status.
+    if ((una_dmm_status == UNA_DMM_SUCCESS) && (read_status.all == 0)) {
+        scan_period_seconds = UNA_get_seconds((uint32_t) SWREG_read_field(reg_value, DMM_REGISTER_CONFIGURATION_0_MASK_NODE_SCAN_PERIOD));
+    }
+    // Update next scan time.
+    node_ctx.scan_next_time_seconds += scan_period_seconds;
+}
+
+/*******************************************************************/
+static void _NODE_update_registry(void) {
+    // Local variables.
+    uint8_t board_id = UNA_BOARD_ID_ERROR;
+    uint16_t idx = 0;
+    // Reset lookup tables.
+    for (idx = 0; idx < NODE_REGISTRY_ADDRESS_RANGE; idx++) {
+        node_ctx.registry.list_index[idx] = NODE_LIST_SIZE;
+    }
+    for (idx = 0; idx < UNA_BOARD_ID_LAST; idx++) {
+        node_ctx.registry.board_list_index[idx] = NODE_LIST_SIZE;
+    }
+    // Index current list.
+    for (idx = 0; idx < NODE_LIST.count; idx++) {
+        node_ctx.registry.list_index[(uint8_t) NODE_LIST.list[idx].address] = (uint8_t) idx;
+        // Keep first node of each board ID.
+        board_id = NODE_LIST.list[idx].board_id;
+        if ((board_id < UNA_BOARD_ID_LAST) && (node_ctx.registry.board_list_index[board_id] >= NODE_LIST_SIZE)) {
+            node_ctx.registry.board_list_index[board_id] = (uint8_t) idx;
+        }
+    }
+    // Notify users that the list has changed.
+    node_ctx.registry.generation++;
+}
+
+/*******************************************************************/
+static uint8_t _NODE_get_list_index(UNA_node_address_t node_addr) {
+    // Direct lookup.
+    return node_ctx.registry.list_index[(uint8_t) node_addr];
+}
+
+/*******************************************************************/
+static uint8_t _NODE_get_low_baud_rate_flag(UNA_node_address_t node_addr) {
+    // Read address bit.
+    return ((node_ctx.registry.low_baud_rate[((uint8_t) node_addr) >> 3] >> (((uint8_t) node_addr) & 0x07)) & 0x01);
+}
+
+/*******************************************************************/
+static void _NODE_set_low_baud_rate_flag(UNA_node_address_t node_addr, uint8_t flag) {
+    // Update address bit.
+    if (flag != 0) {
+        node_ctx.registry.low_baud_rate[((uint8_t) node_addr) >> 3] |= (0x01 << (((uint8_t) node_addr) & 0x07));
+    }
+    else {
+        node_ctx.registry.low_baud_rate[((uint8_t) node_addr) >> 3] &= ~(0x01 << (((uint8_t) node_addr) & 0x07));
+    }
+}
+
+/*******************************************************************/
+static void _NODE_reset_low_baud_rate_flags(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset all addresses.
+    for (idx = 0; idx < (NODE_REGISTRY_ADDRESS_RANGE >> 3); idx++) {
+        node_ctx.registry.low_baud_rate[idx] = 0;
+    }
+}
+
+/*******************************************************************/
+static void _NODE_reset_rtt(NODE_rtt_t* rtt) {
+    // Reset statistics.
+    rtt->ewma_ms = 0;
+    rtt->max_ms = 0;
+    rtt->sample_count = 0;
+}
+
+/*******************************************************************/
+static void _NODE_reset_statistics(NODE_statistics_t* statistics) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset counters.
+    statistics->transaction_count = 0;
+    statistics->timeout_count = 0;
+    statistics->unhealthy_access_count = 0;
+    statistics->byte_count = 0;
+    statistics->bus_time_ms = 0;
+    for (idx = 0; idx < NODE_STATISTICS_LATENCY_BIN_COUNT; idx++) {
+        statistics->latency_histogram[idx] = 0;
+    }
+}
+
+/*******************************************************************/
+static void _NODE_reset_link(uint8_t list_idx) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset to default baud rate.
+    node_ctx.link[list_idx].baud_rate_index = NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT;
+    node_ctx.link[list_idx].failure_count = 0;
+    // Round-trip times depend on the baud rate.
+    for (idx = 0; idx < NODE_RTT_CLASS_LAST; idx++) {
+        _NODE_reset_rtt(&(node_ctx.link[list_idx].rtt[idx]));
+    }
+    // Reset presence.
+    node_ctx.link[list_idx].scan_miss_count = 0;
+    // Reset health.
+    node_ctx.link[list_idx].health = NODE_HEALTH_HEALTHY;
+    node_ctx.link[list_idx].health_failure_count = 0;
+    node_ctx.link[list_idx].health_backoff_exponent = 0;
+    node_ctx.link[list_idx].health_probe_time_seconds = 0;
+    // Reset statistics.
+    _NODE_reset_statistics(&(node_ctx.link[list_idx].statistics));
+}
+
+/*******************************************************************/
+static NODE_rtt_class_t _NODE_get_rtt_class(UNA_node_t* node, uint8_t reg_addr) {
+    // Registers with long static timeout (triggers) are tracked separately.
+    return ((NODES[node->board_id].register_table[reg_addr].timeout_ms > NODE_RTT_CLASS_SLOW_THRESHOLD_MS) ? NODE_RTT_CLASS_SLOW : NODE_RTT_CLASS_FAST);
+}
+
+/*******************************************************************/
+static uint32_t _NODE_get_timeout_ms(UNA_node_t* node, uint8_t reg_addr) {
+    // Local variables.
+    uint32_t table_timeout_ms = NODES[node->board_id].register_table[reg_addr].timeout_ms;
+    uint32_t timeout_ms = table_timeout_ms;
+    uint8_t list_idx = _NODE_get_list_index(node->address);
+    NODE_rtt_t* rtt = NULL;
+    // Use static timeout if the node is unknown.
+    if (list_idx >= NODE_LIST_SIZE) goto errors;
+    rtt = &(node_ctx.link[list_idx].rtt[_NODE_get_rtt_class(node, reg_addr)]);
+    // Use static timeout until enough samples have been collected.
+    if ((rtt->sample_count) < NODE_RTT_SAMPLE_COUNT_MIN) goto errors;
+    // Compute adaptive timeout.
+    timeout_ms = ((rtt->max_ms) > ((rtt->ewma_ms) << 1)) ? (rtt->max_ms) : ((rtt->ewma_ms) << 1);
+    timeout_ms += NODE_RTT_TIMEOUT_MARGIN_MS;
+    // Apply bounds.
+    if (timeout_ms < NODE_RTT_TIMEOUT_MIN_MS) {
+        timeout_ms = NODE_RTT_TIMEOUT_MIN_MS;
+    }
+    if (timeout_ms > table_timeout_ms) {
+        timeout_ms = table_timeout_ms;
+    }
+errors:
+    return timeout_ms;
+}
+
+/*******************************************************************/
+static void _NODE_update_rtt(UNA_node_t* node, uint8_t reg_addr, UNA_access_status_t* access_status) {
+    // Local variables.
+    uint8_t list_idx = _NODE_get_list_index(node->address);
+    NODE_rtt_t* rtt = NULL;
+    // Check index.
+    if (list_idx >= NODE_LIST_SIZE) goto errors;
+    rtt = &(node_ctx.link[list_idx].rtt[_NODE_get_rtt_class(node, reg_addr)]);
+    // Check access status.
+    if ((access_status->flags) != 0) {
+        // Come back to static timeout in case the node became slower.
+        if ((access_status->reply_timeout) != 0) {
+            _NODE_reset_rtt(rtt);
+        }
+        goto errors;
+    }
+    // Update statistics.
+    if ((rtt->sample_count) == 0) {
+        rtt->ewma_ms = node_ctx.reply_wait_ms;
+        rtt->max_ms = node_ctx.reply_wait_ms;
+    }
+    else {
+        rtt->ewma_ms = (((rtt->ewma_ms) * 7) + node_ctx.reply_wait_ms) >> 3;
+        // Slowly forget old peaks.
+        rtt->max_ms = (node_ctx.reply_wait_ms > (rtt->max_ms)) ? node_ctx.reply_wait_ms : ((rtt->max_ms) - ((rtt->max_ms) >> 4));
+    }
+    if ((rtt->sample_count) < 0xFF) {
+        rtt->sample_count++;
+    }
+errors:
+    return;
+}
+
+/*******************************************************************/
+static NODE_una_at_baud_rate_index_t _NODE_get_baud_rate_index(UNA_node_t* node) {
+    // Local variables.
+    NODE_una_at_baud_rate_index_t baud_rate_index = NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT;
+    uint8_t list_idx = _NODE_get_list_index(node->address);
+    // Use negotiated baud rate if the node is known.
+    if (list_idx < NODE_LIST_SIZE) {
+        baud_rate_index = node_ctx.link[list_idx].baud_rate_index;
+    }
+    return baud_rate_index;
+}
+
+/*******************************************************************/
+static void _NODE_update_link(UNA_node_t* node, UNA_access_status_t* access_status) {
+    // Local variables.
+    uint8_t list_idx = _NODE_get_list_index(node->address);
+    uint8_t idx = 0;
+    // Check index.
+    if (list_idx >= NODE_LIST_SIZE) goto errors;
+    // Nothing to do at default baud rate.
+    if (node_ctx.link[list_idx].baud_rate_index == NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT) goto errors;
+    // Check access status.
+    if ((access_status->flags) == 0) {
+        node_ctx.link[list_idx].failure_count = 0;
+        goto errors;
+    }
+    node_ctx.link[list_idx].failure_count++;
+    // Fall back to default baud rate after repeated failures.
+    if (node_ctx.link[list_idx].failure_count >= NODE_UNA_AT_BAUD_RATE_FAILURE_MAX) {
+        node_ctx.link[list_idx].baud_rate_index = NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT;
+        node_ctx.link[list_idx].failure_count = 0;
+        for (idx = 0; idx < NODE_RTT_CLASS_LAST; idx++) {
+            _NODE_reset_rtt(&(node_ctx.link[list_idx].rtt[idx]));
+        }
+    }
+errors:
+    return;
+}
+
+/*******************************************************************/
+static void _NODE_update_statistics(UNA_node_t* node, UNA_access_status_t* access_status, UNA_reply_type_t reply_type) {
+    // Local variables.
+    NODE_statistics_t* statistics[2] = { &(node_ctx.statistics), NULL };
+    uint8_t list_idx = _NODE_get_list_index(node->address);
+    uint32_t byte_count = 0;
+    uint8_t bin_idx = 0;
+    uint8_t unhealthy = 0;
+    uint8_t idx = 0;
+    // Node statistics are only available for listed nodes.
+    if (list_idx < NODE_LIST_SIZE) {
+        statistics[1] = &(node_ctx.link[list_idx].statistics);
+        // Count accesses to a node whose previous access failed (retransmissions are internal to the UNA drivers).
+        unhealthy = (node_ctx.link[list_idx].health != NODE_HEALTH_HEALTHY) ? 1 : 0;
+    }
+    // Compute exchanged bytes.
+    if (NODES[node->board_id].protocol == NODE_PROTOCOL_UNA_R4S8CR) {
+        byte_count = NODE_UNA_R4S8CR_REQUEST_SIZE_BYTES;
+        if (((access_status->reply_timeout) == 0) && (reply_type != UNA_REPLY_TYPE_NONE)) {
+            byte_count += NODE_UNA_R4S8CR_REPLY_SIZE_BYTES;
+        }
+    }
+    else {
+        byte_count = NODE_UNA_AT_REQUEST_SIZE_BYTES;
+        if (((access_status->reply_timeout) == 0) && (reply_type != UNA_REPLY_TYPE_NONE)) {
+            byte_count += NODE_UNA_AT_REPLY_SIZE_BYTES;
+        }
+    }
+    // Compute latency bin.
+    while ((bin_idx < (NODE_STATISTICS_LATENCY_BIN_COUNT - 1)) && (node_ctx.reply_wait_ms >= NODE_STATISTICS_LATENCY_BIN_THRESHOLD_MS[bin_idx])) {
+        bin_idx++;
+    }
+    // Update bus and node statistics.
+    for (idx = 0; idx < 2; idx++) {
+        if (statistics[idx] == NULL) continue;
+        statistics[idx]->transaction_count++;
+        statistics[idx]->byte_count += byte_count;
+        statistics[idx]->unhealthy_access_count += unhealthy;
+        if ((access_status->reply_timeout) != 0) {
+            statistics[idx]->timeout_count++;
+        }
+        // Reply waiting time is only measured on the UNA AT interface.
+        if ((NODES[node->board_id].protocol == NODE_PROTOCOL_UNA_AT) && (reply_type != UNA_REPLY_TYPE_NONE)) {
+            statistics[idx]->bus_time_ms += node_ctx.reply_wait_ms;
+            if ((access_status->flags) == 0) {
+                statistics[idx]->latency_histogram[bin_idx]++;
+            }
+        }
+    }
+}
+
+/*******************************************************************/
+static NODE_status_t _NODE_check_bus_voltage(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    int32_t bus_voltage_mv = 0;
+    uint8_t bus_voltage_low = 0;
+    // Check voltage only once per session.
+    if (node_ctx.session.bus_voltage_checked != 0) goto errors;
+    // Measure RS485 bus voltage.
+    POWER_enable(POWER_REQUESTER_ID_NODE, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_ACTIVE);
+    analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_RS485_BUS_VOLTAGE_MV, &bus_voltage_mv);
+    POWER_disable(POWER_REQUESTER_ID_NODE, POWER_DOMAIN_ANALOG);
+    ANALOG_exit_error(NODE_ERROR_BASE_ANALOG);
+    // Update flags.
+    bus_voltage_low = (bus_voltage_mv < NODE_RS485_BUS_VOLTAGE_MIN_MV) ? 1 : 0;
+    node_ctx.session.bus_voltage_checked = 1;
+    // Store error on brown-out detection only.
+    if ((bus_voltage_low != 0) && (node_ctx.bus_voltage_low == 0)) {
+        ERROR_stack_add(ERROR_BASE_NODE + NODE_ERROR_RS485_BUS_VOLTAGE);
+    }
+    node_ctx.bus_voltage_low = bus_voltage_low;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static NODE_status_t _NODE_check_access(UNA_node_t* node, uint8_t* access_allowed) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint8_t list_idx = _NODE_get_list_index(node->address);
+    // Reset result.
+    (*access_allowed) = 0;
+    // Skip transaction while the bus is browned out.
+    status = _NODE_check_bus_voltage();
+    if (status != NODE_SUCCESS) goto errors;
+    if (node_ctx.bus_voltage_low != 0) goto errors;
+    // Skip quarantined nodes until the next probe time.
+    if ((list_idx < NODE_LIST_SIZE) && (node_ctx.link[list_idx].health == NODE_HEALTH_QUARANTINED) && (RTC_get_uptime_seconds() < node_ctx.link[list_idx].health_probe_time_seconds)) goto errors;
+    // Access is allowed.
+    (*access_allowed) = 1;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static uint8_t _NODE_update_health(UNA_node_t* node, UNA_access_status_t* access_status) {
+    // Local variables.
+    uint8_t list_idx = _NODE_get_list_index(node->address);
+    NODE_link_t* link = NULL;
+    NODE_health_t previous_health = NODE_HEALTH_HEALTHY;
+    uint32_t backoff_seconds = 0;
+    uint8_t transition = 1;
+    // Unknown nodes are not tracked.
+    if (list_idx >= NODE_LIST_SIZE) goto errors;
+    link = &(node_ctx.link[list_idx]);
+    previous_health = (link->health);
+    // Check access status.
+    if ((access_status->flags) == 0) {
+        link->health = NODE_HEALTH_HEALTHY;
+        link->health_failure_count = 0;
+        link->health_backoff_exponent = 0;
+    }
+    else {
+        if ((link->health_failure_count) < 0xFF) {
+            link->health_failure_count++;
+        }
+        if (((link->health) == NODE_HEALTH_QUARANTINED) || ((link->health_failure_count) >= NODE_HEALTH_QUARANTINE_THRESHOLD)) {
+            // Exponential backoff before next probe.
+            backoff_seconds = (NODE_HEALTH_BACKOFF_MIN_SECONDS << (link->health_backoff_exponent));
+            if (backoff_seconds > NODE_HEALTH_BACKOFF_MAX_SECONDS) {
+                backoff_seconds = NODE_HEALTH_BACKOFF_MAX_SECONDS;
+            }
+            if ((link->health_backoff_exponent) < NODE_HEALTH_BACKOFF_EXPONENT_MAX) {
+                link->health_backoff_exponent++;
+            }
+            link->health = NODE_HEALTH_QUARANTINED;
+            link->health_probe_time_seconds = (RTC_get_uptime_seconds() + backoff_seconds);
+        }
+        else {
+            link->health = NODE_HEALTH_SUSPECT;
+        }
+    }
+    transition = ((link->health) != previous_health) ? 1 : 0;
+errors:
+    return transition;
+}
+
+/*******************************************************************/
+static void _NODE_remove_from_list(uint8_t list_idx) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Flush related cache entries.
+    _NODE_cache_invalidate(NODE_LIST.list[list_idx].address, 0);
+    // Another board may use this address later.
+    _NODE_set_low_baud_rate_flag(NODE_LIST.list[list_idx].address, 0);
+    // Shift following nodes to keep the list order.
+    for (idx = list_idx; idx < (NODE_LIST.count - 1); idx++) {
+        NODE_LIST.list[idx].address = NODE_LIST.list[idx + 1].address;
+        NODE_LIST.list[idx].board_id = NODE_LIST.list[idx + 1].board_id;
+        node_ctx.link[idx] = node_ctx.link[idx + 1];
+    }
+    NODE_LIST.count--;
+    _NODE_reset_link(NODE_LIST.count);
+    NODE_LIST.list[NODE_LIST.count].address = UNA_NODE_ADDRESS_ERROR;
+    NODE_LIST.list[NODE_LIST.count].board_id = UNA_BOARD_ID_ERROR;
+    // Update registry.
+    _NODE_update_registry();
+}
+
+/*******************************************************************/
+static NODE_status_t _NODE_probe(UNA_node_address_t node_addr, NODE_una_at_baud_rate_index_t baud_rate_index, UNA_node_t* node, uint8_t* node_found) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
+    UNA_access_parameters_t read_params;
+    UNA_access_status_t read_status;
+    uint32_t reg_value = 0;
+    uint8_t board_id = UNA_BOARD_ID_ERROR;
+    // Reset result.
+    (*node_found) = 0;
+    // Configure UNA AT interface.
+    status = _NODE_select_protocol(NODE_PROTOCOL_UNA_AT, baud_rate_index);
+    if (status != NODE_SUCCESS) goto errors;
+    // Read node ID register.
+    read_params.node_addr = node_addr;
+    read_params.reg_addr = UNA_AT_SCAN_REGISTER_ADDRESS;
+    read_params.reply_params.type = UNA_REPLY_TYPE_VALUE;
+    read_params.reply_params.timeout_ms = UNA_AT_SCAN_REGISTER_TIMEOUT_MS;
+    una_at_status = UNA_AT_read_register(&read_params, &reg_value, &read_status);
+    UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
+    // Check reply.
+    if ((read_status.flags != 0) || (SWREG_read_field(reg_value, UNA_AT_SCAN_REGISTER_MASK_NODE_ADDRESS) != node_addr)) goto errors;
+    board_id = (uint8_t) SWREG_read_field(reg_value, UNA_AT_SCAN_REGISTER_MASK_BOARD_ID);
+    if (board_id >= UNA_BOARD_ID_LAST) goto errors;
+    // Update node.
+    node->address = node_addr;
+    node->board_id = board_id;
+    (*node_found) = 1;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static NODE_status_t _NODE_negotiate_baud_rate(uint8_t list_idx) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UNA_node_t node;
+    uint8_t node_found = 0;
+    uint8_t idx = 0;
+    // Reset link.
+    _NODE_reset_link(list_idx);
+    // Negotiation only applies to UNA AT nodes.
+    if (NODES[NODE_LIST.list[list_idx].board_id].protocol != NODE_PROTOCOL_UNA_AT) goto errors;
+    // Do not probe again nodes which are known to only support the default baud rate.
+    if (_NODE_get_low_baud_rate_flag(NODE_LIST.list[list_idx].address) != 0) goto errors;
+    // Try highest baud rates first.
+    for (idx = (NODE_UNA_AT_BAUD_RATE_INDEX_LAST - 1); idx > NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT; idx--) {
+        status = _NODE_probe(NODE_LIST.list[list_idx].address, idx, &node, &node_found);
+        if (status != NODE_SUCCESS) goto errors;
+        // Check result.
+        if ((node_found != 0) && (node.board_id == NODE_LIST.list[list_idx].board_id)) {
+            node_ctx.link[list_idx].baud_rate_index = idx;
+            break;
+        }
+    }
+    // Remember nodes which did not answer at any higher baud rate.
+    if (node_ctx.link[list_idx].baud_rate_index == NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT) {
+        _NODE_set_low_baud_rate_flag(NODE_LIST.list[list_idx].address, 1);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static NODE_status_t _NODE_scan_known_nodes(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UNA_node_t node;
+    uint8_t node_found = 0;
+    uint8_t idx = (NODE_LIST_DMM_NODE_INDEX + 1);
+    // Known nodes loop.
+    while (idx < NODE_LIST.count) {
+        // R4S8CR nodes are checked by the last scan slice.
+        if (NODES[NODE_LIST.list[idx].board_id].protocol != NODE_PROTOCOL_UNA_AT) {
+            idx++;
+            continue;
+        }
+        status = _NODE_probe(NODE_LIST.list[idx].address, node_ctx.link[idx].baud_rate_index, &node, &node_found);
+        if (status != NODE_SUCCESS) goto errors;
+        // Retry at default baud rate before considering the node as missing.
+        if ((node_found == 0) && (node_ctx.link[idx].baud_rate_index != NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT)) {
+            status = _NODE_probe(NODE_LIST.list[idx].address, NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT, &node, &node_found);
+            if (status != NODE_SUCCESS) goto errors;
+            // Node came back to default baud rate.
+            if (node_found != 0) {
+                _NODE_reset_link(idx);
+            }
+        }
+        // Remove node after several consecutive misses only.
+        if (node_found == 0) {
+            node_ctx.link[idx].scan_miss_count++;
+            if (node_ctx.link[idx].scan_miss_count >= NODE_SCAN_MISS_COUNT_MAX) {
+                _NODE_remove_from_list(idx);
+                continue;
+            }
+            idx++;
+            continue;
+        }
+        node_ctx.link[idx].scan_miss_count = 0;
+        if (node.board_id != NODE_LIST.list[idx].board_id) {
+            // Another board took the address.
+            _NODE_cache_invalidate(node.address, 0);
+            _NODE_set_low_baud_rate_flag(node.address, 0);
+            NODE_LIST.list[idx].board_id = node.board_id;
+            _NODE_update_registry();
+            status = _NODE_negotiate_baud_rate(idx);
+            if (status != NODE_SUCCESS) goto errors;
+        }
+        idx++;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static NODE_status_t _NODE_scan_r4s8cr_nodes(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UNA_R4S8CR_status_t una_r4s8cr_status = UNA_R4S8CR_SUCCESS;
+    UNA_node_t r4s8cr_list[NODE_LIST_SIZE];
+    uint8_t node_count = 0;
+    uint8_t node_found = 0;
+    uint8_t list_updated = 0;
+    uint8_t scan_idx = 0;
+    uint8_t idx = (NODE_LIST_DMM_NODE_INDEX + 1);
+    // Scan R4S8CR nodes.
+    status = _NODE_select_protocol(NODE_PROTOCOL_UNA_R4S8CR, NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT);
+    if (status != NODE_SUCCESS) goto errors;
+    una_r4s8cr_status = UNA_R4S8CR_scan((UNA_node_t*) r4s8cr_list, (NODE_LIST_SIZE - NODE_LIST_DMM_NODE_INDEX - 1), &node_count);
+    UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
+    // Remove R4S8CR nodes which are not present anymore.
+    while (idx < NODE_LIST.count) {
+        if (NODES[NODE_LIST.list[idx].board_id].protocol == NODE_PROTOCOL_UNA_R4S8CR) {
+            node_found = 0;
+            for (scan_idx = 0; scan_idx < node_count; scan_idx++) {
+                if ((r4s8cr_list[scan_idx].address == NODE_LIST.list[idx].address) && (r4s8cr_list[scan_idx].board_id == NODE_LIST.list[idx].board_id)) {
+                    node_found = 1;
+                    break;
+                }
+            }
+            // Remove node after several consecutive misses only.
+            if (node_found == 0) {
+                node_ctx.link[idx].scan_miss_count++;
+                if (node_ctx.link[idx].scan_miss_count >= NODE_SCAN_MISS_COUNT_MAX) {
+                    _NODE_remove_from_list(idx);
+                    continue;
+                }
+            }
+            else {
+                node_ctx.link[idx].scan_miss_count = 0;
+            }
+        }
+        idx++;
+    }
+    // Append new R4S8CR nodes.
+    for (scan_idx = 0; scan_idx < node_count; scan_idx++) {
+        // Check list size.
+        if (NODE_LIST.count >= NODE_LIST_SIZE) break;
+        // Check if node is already known.
+        if (_NODE_get_list_index(r4s8cr_list[scan_idx].address) < NODE_LIST_SIZE) continue;
+        NODE_LIST.list[NODE_LIST.count].address = r4s8cr_list[scan_idx].address;
+        NODE_LIST.list[NODE_LIST.count].board_id = r4s8cr_list[scan_idx].board_id;
+        _NODE_reset_link(NODE_LIST.count);
+        NODE_LIST.count++;
+        list_updated = 1;
+    }
+    // Update registry.
+    if (list_updated != 0) {
+        _NODE_update_registry();
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static NODE_status_t _NODE_scan_slice(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint8_t node_found = 0;
+    uint8_t idx = 0;
+    // Addresses loop.
+    for (idx = 0; idx < NODE_SCAN_SLICE_SIZE; idx++) {
+        // Check end of range and list size.
+        if ((node_ctx.scan_address > NODE_SCAN_UNA_AT_ADDRESS_LAST) || (NODE_LIST.count >= NODE_LIST_SIZE)) {
+            node_ctx.scan_address = (NODE_SCAN_UNA_AT_ADDRESS_LAST + 1);
+            break;
+        }
+        // Skip known nodes which have already been probed.
+        if (_NODE_get_list_index(node_ctx.scan_address) >= NODE_LIST_SIZE) {
+            status = _NODE_probe(node_ctx.scan_address, NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT, &(NODE_LIST.list[NODE_LIST.count]), &node_found);
+            if (status != NODE_SUCCESS) goto errors;
+            // Append new node at the end of the list.
+            if (node_found != 0) {
+                NODE_LIST.count++;
+                _NODE_update_registry();
+                status = _NODE_negotiate_baud_rate(NODE_LIST.count - 1);
+                if (status != NODE_SUCCESS) goto errors;
+            }
+        }
+        node_ctx.scan_address++;
+    }
 errors:
     return status;
 }
 
 /*******************************************************************/
-NODE_status_t NODE_de_init(void) {
+static NODE_status_t _NODE_scan_incremental(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
+    uint8_t scan_end = 0;
+    // Turn bus interface on.
+    POWER_enable(POWER_REQUESTER_ID_NODE, POWER_DOMAIN_RS485, LPTIM_DELAY_MODE_STOP);
+    // Check state.
+    if (node_ctx.scan_state == NODE_SCAN_STATE_IDLE) {
+        // Check known nodes first so that the list is directly usable.
+        status = _NODE_scan_known_nodes();
+        if (status != NODE_SUCCESS) goto errors;
+        // Start sweep of unknown addresses on next wake-ups.
+        node_ctx.scan_address = NODE_SCAN_UNA_AT_ADDRESS_FIRST;
+        node_ctx.scan_state = NODE_SCAN_STATE_SWEEP;
+        goto errors;
+    }
+    // Sweep next slice of unknown addresses.
+    status = _NODE_scan_slice();
+    if (status != NODE_SUCCESS) goto errors;
+    // Check end of sweep.
+    if (node_ctx.scan_address > NODE_SCAN_UNA_AT_ADDRESS_LAST) {
+        scan_end = 1;
+        // Update R4S8CR nodes.
+        status = _NODE_scan_r4s8cr_nodes();
+        if (status != NODE_SUCCESS) goto errors;
+    }
+errors:
+    // Terminate scan at the end of the sweep or in case of error.
+    if ((scan_end != 0) || (status != NODE_SUCCESS)) {
+        node_ctx.scan_state = NODE_SCAN_STATE_IDLE;
+        _NODE_update_scan_next_time();
+    }
+    // Release interface if needed.
+    _NODE_end_access();
+    // Turn bus interface off.
+    POWER_disable(POWER_REQUESTER_ID_NODE, POWER_DOMAIN_RS485);
     return status;
 }
 
 /*******************************************************************/
-NODE_status_t NODE_write_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_access_status_t* write_status) {
+static NODE_status_t _NODE_write_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_reply_type_t reply_type, UNA_access_status_t* write_status) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     UNA_DMM_status_t una_dmm_status = UNA_DMM_SUCCESS;
     UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
     UNA_R4S8CR_status_t una_r4s8cr_status = UNA_R4S8CR_SUCCESS;
-    UNA_AT_configuration_t una_at_config;
     UNA_access_parameters_t write_params;
-    uint8_t una_at_init = 0;
-    uint8_t una_r4s8cr_init = 0;
+    uint8_t access_allowed = 0;
+    uint8_t bus_access = 0;
+    uint8_t error_log = 1;
     // Check parameters.
     _NODE_check_node_and_board_id();
     if (write_status == NULL) {
@@ -148,11 +1079,25 @@ NODE_status_t NODE_write_register(UNA_node_t* node, uint8_t reg_addr, uint32_t r
     // Reset status.
     write_status->type = UNA_ACCESS_TYPE_WRITE;
     write_status->flags = 0;
+    // Flush cached value of the written register.
+    _NODE_cache_invalidate_write(node, reg_addr, reg_mask);
     // Common write parameters.
     write_params.node_addr = (node->address);
     write_params.reg_addr = reg_addr;
-    write_params.reply_params.timeout_ms = NODES[node->board_id].register_table[reg_addr].timeout_ms;
-    write_params.reply_params.type = UNA_REPLY_TYPE_OK;
+    write_params.reply_params.timeout_ms = _NODE_get_timeout_ms(node, reg_addr);
+    write_params.reply_params.type = reply_type;
+    // Check bus and node health before any bus transaction.
+    if (NODES[node->board_id].protocol != NODE_PROTOCOL_UNA_DMM) {
+        status = _NODE_check_access(node, &access_allowed);
+        if (status != NODE_SUCCESS) goto errors;
+        // Report a reply timeout without accessing the bus.
+        if (access_allowed == 0) {
+            write_status->reply_timeout = 1;
+            error_log = 0;
+            goto errors;
+        }
+        bus_access = 1;
+    }
     // Check protocol.
     switch (NODES[node->board_id].protocol) {
     case NODE_PROTOCOL_UNA_DMM:
@@ -161,50 +1106,315 @@ NODE_status_t NODE_write_register(UNA_node_t* node, uint8_t reg_addr, uint32_t r
         UNA_DMM_exit_error(NODE_ERROR_BASE_UNA_DMM);
         break;
     case NODE_PROTOCOL_UNA_AT:
+        // Configure UNA AT interface.
+        status = _NODE_select_protocol(NODE_PROTOCOL_UNA_AT, _NODE_get_baud_rate_index(node));
+        if (status != NODE_SUCCESS) goto errors;
         // Write UNA AT node register.
-        una_at_init = 1;
-        una_at_config.baud_rate = NODE_UNA_AT_BAUD_RATE;
-        // UNA-AT transfer.
-        una_at_status = UNA_AT_init(&una_at_config);
-        UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
+        node_ctx.reply_wait_ms = 0;
         una_at_status = UNA_AT_write_register(&write_params, reg_value, reg_mask, write_status);
         UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
-        una_at_status = UNA_AT_de_init();
-        UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
-        una_at_init = 0;
+        // Link statistics can only be updated when a reply is expected.
+        if (reply_type != UNA_REPLY_TYPE_NONE) {
+            _NODE_update_rtt(node, reg_addr, write_status);
+            _NODE_update_link(node, write_status);
+        }
         break;
     case NODE_PROTOCOL_UNA_R4S8CR:
+        // Configure UNA R4S8CR interface.
+        status = _NODE_select_protocol(NODE_PROTOCOL_UNA_R4S8CR, NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT);
+        if (status != NODE_SUCCESS) goto errors;
         // Write UNA R4S8CR node register.
-        una_r4s8cr_init = 1;
-        // UNA-R4S8CR transfer.
-        una_r4s8cr_status = UNA_R4S8CR_init();
-        UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
         una_r4s8cr_status = UNA_R4S8CR_write_register(&write_params, reg_value, reg_mask, write_status);
         UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
-        una_r4s8cr_status = UNA_R4S8CR_de_init();
-        UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
-        una_r4s8cr_init = 0;
         break;
     default:
         status = NODE_ERROR_PROTOCOL;
         goto errors;
     }
 errors:
-    // Force release in case of error.
-    if (una_at_init != 0) {
-        UNA_AT_de_init();
+    // Release interface if needed.
+    _NODE_end_access();
+    // Update statistics before health since unhealthy accesses depend on the previous state.
+    if ((bus_access != 0) && (status == NODE_SUCCESS)) {
+        _NODE_update_statistics(node, write_status, reply_type);
     }
-    if (una_r4s8cr_init != 0) {
-        UNA_R4S8CR_de_init();
+    // Update node health.
+    if ((bus_access != 0) && (reply_type != UNA_REPLY_TYPE_NONE)) {
+        error_log = _NODE_update_health(node, write_status);
     }
-    // Store eventual access status error.
-    if ((write_status->flags) != 0) {
+    // Store eventual access status error on health state change only.
+    if (((write_status->flags) != 0) && (error_log != 0)) {
         ERROR_stack_add(ERROR_BASE_NODE + NODE_ERROR_BASE_ACCESS_STATUS_CODE + (write_status->all));
         ERROR_stack_add(ERROR_BASE_NODE + NODE_ERROR_BASE_ACCESS_STATUS_ADDRESS + (node->address));
     }
     return status;
 }
 
+/*** NODE functions ***/
+
+/*******************************************************************/
+NODE_status_t NODE_init(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UNA_DMM_status_t una_dmm_status = UNA_DMM_SUCCESS;
+    uint8_t idx = 0;
+    // Init context.
+    node_ctx.scan_next_time_seconds = 0;
+    node_ctx.scan_state = NODE_SCAN_STATE_IDLE;
+    node_ctx.scan_address = NODE_SCAN_UNA_AT_ADDRESS_FIRST;
+    for (idx = 0; idx < NODE_LIST_SIZE; idx++) {
+        _NODE_reset_link(idx);
+    }
+    node_ctx.session.depth = 0;
+    node_ctx.session.protocol = NODE_PROTOCOL_LAST;
+    node_ctx.session.baud_rate_index = NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT;
+    node_ctx.session.reconfiguration_count = 0;
+    node_ctx.session.last_reconfiguration_count = 0;
+    _NODE_cache_invalidate(UNA_NODE_ADDRESS_MASTER, 1);
+    _NODE_reset_low_baud_rate_flags();
+    node_ctx.cache.hit_count = 0;
+    node_ctx.cache.miss_count = 0;
+    _NODE_reset_statistics(&(node_ctx.statistics));
+    // Reset node list.
+    UNA_reset_node_list(&NODE_LIST);
+    _NODE_update_registry();
+    // Init self registers.
+    una_dmm_status = UNA_DMM_init();
+    UNA_DMM_exit_error(NODE_ERROR_BASE_UNA_DMM);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t NODE_de_init(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Force session closure.
+    node_ctx.session.depth = 0;
+    node_ctx.session.bus_voltage_checked = 0;
+    status = _NODE_release_protocol();
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t NODE_open_session(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Check depth.
+    if (node_ctx.session.depth == 0xFF) {
+        status = NODE_ERROR_SESSION_STATE;
+        goto errors;
+    }
+    // Reset counter and measure bus voltage again on first opening.
+    if (node_ctx.session.depth == 0) {
+        node_ctx.session.reconfiguration_count = 0;
+        node_ctx.session.bus_voltage_checked = 0;
+    }
+    // Note: the bus interface is configured on first access only.
+    node_ctx.session.depth++;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t NODE_close_session(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Check depth.
+    if (node_ctx.session.depth == 0) {
+        status = NODE_ERROR_SESSION_STATE;
+        goto errors;
+    }
+    node_ctx.session.depth--;
+    // Release interface when the outer session is closed.
+    if (node_ctx.session.depth == 0) {
+        node_ctx.session.last_reconfiguration_count = node_ctx.session.reconfiguration_count;
+        node_ctx.session.bus_voltage_checked = 0;
+        status = _NODE_release_protocol();
+        if (status != NODE_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+uint32_t NODE_get_bus_reconfiguration_count(void) {
+    // Return the counter of the current session, or of the last one if no session is opened.
+    return ((node_ctx.session.depth != 0) ? node_ctx.session.reconfiguration_count : node_ctx.session.last_reconfiguration_count);
+}
+
+/*******************************************************************/
+NODE_status_t NODE_get_cache_statistics(uint32_t* hit_count, uint32_t* miss_count) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Check parameters.
+    if ((hit_count == NULL) || (miss_count == NULL)) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*hit_count) = node_ctx.cache.hit_count;
+    (*miss_count) = node_ctx.cache.miss_count;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void NODE_update_bus_wait_time(uint32_t delay_ms) {
+    // Update counters.
+    node_ctx.reply_wait_ms += delay_ms;
+    node_ctx.bus_wait_time_ms += delay_ms;
+}
+
+/*******************************************************************/
+uint32_t NODE_get_bus_wait_time_ms(void) {
+    // Return cumulated time.
+    return (node_ctx.bus_wait_time_ms);
+}
+
+/*******************************************************************/
+NODE_status_t NODE_get_statistics(UNA_node_address_t node_addr, NODE_statistics_t* statistics) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint8_t list_idx = 0;
+    // Check parameter.
+    if (statistics == NULL) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Master address gives the whole bus statistics.
+    if (node_addr == UNA_NODE_ADDRESS_MASTER) {
+        (*statistics) = node_ctx.statistics;
+        goto errors;
+    }
+    // Search node.
+    status = NODE_get_list_index(node_addr, &list_idx);
+    if (status != NODE_SUCCESS) goto errors;
+    (*statistics) = node_ctx.link[list_idx].statistics;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+uint32_t NODE_get_list_generation(void) {
+    // Return registry generation.
+    return (node_ctx.registry.generation);
+}
+
+/*******************************************************************/
+NODE_status_t NODE_get_list_index(UNA_node_address_t node_addr, uint8_t* list_index) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Check parameter.
+    if (list_index == NULL) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*list_index) = _NODE_get_list_index(node_addr);
+    // Check result.
+    if ((*list_index) >= NODE_LIST_SIZE) {
+        status = NODE_ERROR_NODE_ADDRESS;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t NODE_get_board_list_index(uint8_t board_id, uint8_t* list_index) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    // Check parameters.
+    if (list_index == NULL) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (board_id >= UNA_BOARD_ID_LAST) {
+        status = NODE_ERROR_NOT_SUPPORTED;
+        goto errors;
+    }
+    (*list_index) = node_ctx.registry.board_list_index[board_id];
+    // Check result.
+    if ((*list_index) >= NODE_LIST_SIZE) {
+        status = NODE_ERROR_NODE_ADDRESS;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t NODE_get_health(UNA_node_address_t node_addr, NODE_health_t* health) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint8_t list_idx = 0;
+    // Check parameter.
+    if (health == NULL) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Search node.
+    status = NODE_get_list_index(node_addr, &list_idx);
+    if (status != NODE_SUCCESS) goto errors;
+    (*health) = node_ctx.link[list_idx].health;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t NODE_write_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_access_status_t* write_status) {
+    // Write register with acknowledge.
+    return _NODE_write_register(node, reg_addr, reg_value, reg_mask, UNA_REPLY_TYPE_OK, write_status);
+}
+
+/*******************************************************************/
+NODE_status_t NODE_send_register(UNA_node_t* node, uint8_t reg_addr, uint32_t reg_value, uint32_t reg_mask, UNA_access_status_t* write_status) {
+    // Write register without waiting for the reply.
+    return _NODE_write_register(node, reg_addr, reg_value, reg_mask, UNA_REPLY_TYPE_NONE, write_status);
+}
+
+/*******************************************************************/
+NODE_status_t NODE_write_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint32_t* reg_value_list, uint32_t* reg_mask_list, uint8_t reg_list_size, UNA_access_status_t* write_status, uint8_t* write_count) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    uint8_t idx = 0;
+    // Check node and board ID.
+    _NODE_check_node_and_board_id();
+    // Check parameters.
+    if ((reg_addr_list == NULL) || (reg_value_list == NULL) || (reg_mask_list == NULL) || (write_status == NULL) || (write_count == NULL)) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (reg_list_size == 0) {
+        status = NODE_ERROR_REGISTER_ADDRESS_LIST_SIZE;
+        goto errors;
+    }
+    // Reset outputs.
+    write_status->all = 0;
+    write_status->type = UNA_ACCESS_TYPE_WRITE;
+    (*write_count) = 0;
+    // Send all requests back-to-back without releasing the bus interface.
+    status = NODE_open_session();
+    if (status != NODE_SUCCESS) goto errors;
+    // Registers loop.
+    for (idx = 0; idx < reg_list_size; idx++) {
+        // Write register.
+        status = _NODE_write_register(node, reg_addr_list[idx], reg_value_list[idx], reg_mask_list[idx], UNA_REPLY_TYPE_OK, write_status);
+        if (status != NODE_SUCCESS) break;
+        // Following registers may depend on this one: stop on first failure.
+        if ((write_status->flags) != 0) break;
+        (*write_count)++;
+    }
+    // Close session.
+    if (status == NODE_SUCCESS) {
+        status = NODE_close_session();
+    }
+    else {
+        NODE_close_session();
+    }
+errors:
+    return status;
+}
+
 /*******************************************************************/
 NODE_status_t NODE_perform_measurements(UNA_node_t* node, UNA_access_status_t* write_status) {
     // Local variables.
@@ -243,13 +1453,15 @@ NODE_status_t NODE_read_register(UNA_node_t* node, uint8_t reg_addr, uint32_t* r
     UNA_DMM_status_t una_dmm_status = UNA_DMM_SUCCESS;
     UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
     UNA_R4S8CR_status_t una_r4s8cr_status = UNA_R4S8CR_SUCCESS;
-    UNA_AT_configuration_t una_at_config;
     UNA_access_parameters_t read_params;
-    uint8_t una_at_init = 0;
-    uint8_t una_r4s8cr_init = 0;
+    uint8_t access_allowed = 0;
+    uint8_t bus_access = 0;
+    uint8_t error_log = 1;
+    NODE_cache_policy_t cache_policy = NODE_CACHE_POLICY_VOLATILE;
+    NODE_cache_entry_t* cache_entry = NULL;
     // Check parameters.
     _NODE_check_node_and_board_id();
-    if (read_status == NULL) {
+    if ((reg_value == NULL) || (read_status == NULL)) {
         status = NODE_ERROR_NULL_PARAMETER;
         goto errors;
     }
@@ -259,8 +1471,32 @@ NODE_status_t NODE_read_register(UNA_node_t* node, uint8_t reg_addr, uint32_t* r
     // Write parameters.
     read_params.node_addr = (node->address);
     read_params.reg_addr = reg_addr;
-    read_params.reply_params.timeout_ms = NODES[node->board_id].register_table[reg_addr].timeout_ms;
+    read_params.reply_params.timeout_ms = _NODE_get_timeout_ms(node, reg_addr);
     read_params.reply_params.type = UNA_REPLY_TYPE_VALUE;
+    // Check cache.
+    cache_policy = _NODE_get_cache_policy(node, reg_addr);
+    if (cache_policy != NODE_CACHE_POLICY_VOLATILE) {
+        cache_entry = _NODE_cache_search(node->address, reg_addr);
+        // Check entry validity.
+        if ((cache_entry != NULL) && ((cache_policy == NODE_CACHE_POLICY_STATIC) || ((RTC_get_uptime_seconds() - (cache_entry->timestamp_seconds)) < NODE_CACHE_TTL_SECONDS))) {
+            (*reg_value) = (cache_entry->reg_value);
+            node_ctx.cache.hit_count++;
+            goto errors;
+        }
+        node_ctx.cache.miss_count++;
+    }
+    // Check bus and node health before any bus transaction.
+    if (NODES[node->board_id].protocol != NODE_PROTOCOL_UNA_DMM) {
+        status = _NODE_check_access(node, &access_allowed);
+        if (status != NODE_SUCCESS) goto errors;
+        // Report a reply timeout without accessing the bus.
+        if (access_allowed == 0) {
+            read_status->reply_timeout = 1;
+            error_log = 0;
+            goto errors;
+        }
+        bus_access = 1;
+    }
     // Check protocol.
     switch (NODES[node->board_id].protocol) {
     case NODE_PROTOCOL_UNA_DMM:
@@ -269,44 +1505,45 @@ NODE_status_t NODE_read_register(UNA_node_t* node, uint8_t reg_addr, uint32_t* r
         UNA_DMM_exit_error(NODE_ERROR_BASE_UNA_DMM);
         break;
     case NODE_PROTOCOL_UNA_AT:
-        // Write UNA AT node register.
-        una_at_init = 1;
-        una_at_config.baud_rate = NODE_UNA_AT_BAUD_RATE;
-        // UNA-AT transfer.
-        una_at_status = UNA_AT_init(&una_at_config);
-        UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
+        // Configure UNA AT interface.
+        status = _NODE_select_protocol(NODE_PROTOCOL_UNA_AT, _NODE_get_baud_rate_index(node));
+        if (status != NODE_SUCCESS) goto errors;
+        // Read UNA AT node register.
+        node_ctx.reply_wait_ms = 0;
         una_at_status = UNA_AT_read_register(&read_params, reg_value, read_status);
         UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
-        una_at_status = UNA_AT_de_init();
-        UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
-        una_at_init = 0;
+        _NODE_update_rtt(node, reg_addr, read_status);
+        _NODE_update_link(node, read_status);
         break;
     case NODE_PROTOCOL_UNA_R4S8CR:
-        // Write UNA R4S8CR node register.
-        una_r4s8cr_init = 1;
-        // UNA-R4S8CR transfer.
-        una_r4s8cr_status = UNA_R4S8CR_init();
-        UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
+        // Configure UNA R4S8CR interface.
+        status = _NODE_select_protocol(NODE_PROTOCOL_UNA_R4S8CR, NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT);
+        if (status != NODE_SUCCESS) goto errors;
+        // Read UNA R4S8CR node register.
         una_r4s8cr_status = UNA_R4S8CR_read_register(&read_params, reg_value, read_status);
         UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
-        una_r4s8cr_status = UNA_R4S8CR_de_init();
-        UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
-        una_r4s8cr_init = 0;
         break;
     default:
         status = NODE_ERROR_PROTOCOL;
         goto errors;
     }
+    // Update cache.
+    if ((cache_policy != NODE_CACHE_POLICY_VOLATILE) && ((read_status->flags) == 0)) {
+        _NODE_cache_store(node->address, reg_addr, (*reg_value));
+    }
 errors:
-    // Force release in case of error.
-    if (una_at_init != 0) {
-        UNA_AT_de_init();
+    // Release interface if needed.
+    _NODE_end_access();
+    // Update statistics before health since unhealthy accesses depend on the previous state.
+    if ((bus_access != 0) && (status == NODE_SUCCESS)) {
+        _NODE_update_statistics(node, read_status, UNA_REPLY_TYPE_VALUE);
     }
-    if (una_r4s8cr_init != 0) {
-        UNA_R4S8CR_de_init();
+    // Update node health.
+    if (bus_access != 0) {
+        error_log = _NODE_update_health(node, read_status);
     }
-    // Store eventual access status error.
-    if ((read_status->flags) != 0) {
+    // Store eventual access status error on health state change only.
+    if (((read_status->flags) != 0) && (error_log != 0)) {
         ERROR_stack_add(ERROR_BASE_NODE + NODE_ERROR_BASE_ACCESS_STATUS_CODE + (read_status->all));
         ERROR_stack_add(ERROR_BASE_NODE + NODE_ERROR_BASE_ACCESS_STATUS_ADDRESS + (node->address));
     }
@@ -314,10 +1551,12 @@ errors:
 }
 
 /*******************************************************************/
-NODE_status_t NODE_read_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint8_t reg_addr_list_size, uint32_t* node_registers, UNA_access_status_t* read_status) {
+NODE_status_t NODE_read_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint8_t reg_addr_list_size, uint32_t* node_registers, UNA_access_status_t* read_status_list, UNA_access_status_t* read_status) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
+    UNA_access_status_t reg_read_status;
     uint8_t reg_addr = 0;
+    uint8_t success_count = 0;
     uint8_t idx = 0;
     // Check node and board ID.
     _NODE_check_node_and_board_id();
@@ -330,87 +1569,134 @@ NODE_status_t NODE_read_registers(UNA_node_t* node, uint8_t* reg_addr_list, uint
         status = NODE_ERROR_REGISTER_ADDRESS_LIST_SIZE;
         goto errors;
     }
+    // Reset global status.
+    read_status->all = 0;
+    read_status->type = UNA_ACCESS_TYPE_READ;
+    // Send all requests back-to-back without releasing the bus interface.
+    status = NODE_open_session();
+    if (status != NODE_SUCCESS) goto errors;
     // Registers loop.
     for (idx = 0; idx < reg_addr_list_size; idx++) {
         // Update register address.
         reg_addr = reg_addr_list[idx];
         // Read register.
-        status = NODE_read_register(node, reg_addr, &(node_registers[reg_addr]), read_status);
-        if (status != NODE_SUCCESS) goto errors;
+        status = NODE_read_register(node, reg_addr, &(node_registers[reg_addr]), &reg_read_status);
+        if (status != NODE_SUCCESS) break;
+        // Check access status.
+        if (reg_read_status.flags == 0) {
+            success_count++;
+        }
+        else {
+            // Use error value so that partial payloads can still be built.
+            node_registers[reg_addr] = NODES[node->board_id].register_table[reg_addr].error_value;
+            // Keep last failure.
+            read_status->all = reg_read_status.all;
+        }
+        // Update status list if required.
+        if (read_status_list != NULL) {
+            read_status_list[idx].all = reg_read_status.all;
+        }
+    }
+    // Close session.
+    if (status == NODE_SUCCESS) {
+        status = NODE_close_session();
+    }
+    else {
+        NODE_close_session();
+    }
+    if (status != NODE_SUCCESS) goto errors;
+    // Global status is only failed when no register could be read.
+    if (success_count != 0) {
+        read_status->flags = 0;
     }
 errors:
     return status;
 }
 
 /*******************************************************************/
-NODE_status_t NODE_scan(void) {
+NODE_status_t NODE_poll_register(UNA_node_t* node, uint8_t reg_addr, uint32_t* reg_value, UNA_access_status_t* read_status) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
     UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
-    UNA_R4S8CR_status_t una_r4s8cr_status = UNA_R4S8CR_SUCCESS;
-    UNA_DMM_status_t una_dmm_status = UNA_DMM_SUCCESS;
-    UNA_AT_configuration_t una_at_config;
     UNA_access_parameters_t read_params;
-    UNA_access_status_t read_status;
-    uint32_t reg_value = 0;
-    uint32_t scan_period_seconds = NODE_SCAN_PERIOD_DEFAULT_SECONDS;
+    // Check parameters.
+    _NODE_check_node_and_board_id();
+    if ((reg_value == NULL) || (read_status == NULL)) {
+        status = NODE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset status.
+    read_status->type = UNA_ACCESS_TYPE_READ;
+    read_status->flags = 0;
+    // Only remote nodes can be busy.
+    if (NODES[node->board_id].protocol != NODE_PROTOCOL_UNA_AT) {
+        status = NODE_ERROR_PROTOCOL;
+        goto errors;
+    }
+    // Flush reception: the deferred reply of a command sent without waiting for it must not be parsed as the register value.
+    status = _NODE_release_protocol();
+    if (status != NODE_SUCCESS) goto errors;
+    // Configure UNA AT interface.
+    status = _NODE_select_protocol(NODE_PROTOCOL_UNA_AT, _NODE_get_baud_rate_index(node));
+    if (status != NODE_SUCCESS) goto errors;
+    // Read register with short timeout: cache, statistics and health are not updated since no reply is expected while the node is busy.
+    read_params.node_addr = (node->address);
+    read_params.reg_addr = reg_addr;
+    read_params.reply_params.type = UNA_REPLY_TYPE_VALUE;
+    read_params.reply_params.timeout_ms = UNA_AT_SCAN_REGISTER_TIMEOUT_MS;
+    una_at_status = UNA_AT_read_register(&read_params, reg_value, read_status);
+    UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
+errors:
+    // Release interface if needed.
+    _NODE_end_access();
+    return status;
+}
+
+/*******************************************************************/
+NODE_status_t NODE_scan(void) {
+    // Local variables.
+    NODE_status_t status = NODE_SUCCESS;
+    UNA_AT_status_t una_at_status = UNA_AT_SUCCESS;
     uint8_t node_count = 0;
-    uint8_t una_at_init = 0;
-    uint8_t una_r4s8cr_init = 0;
+    uint8_t idx = 0;
     // Reset list.
     UNA_reset_node_list(&NODE_LIST);
+    // Flush register cache.
+    _NODE_cache_invalidate(UNA_NODE_ADDRESS_MASTER, 1);
+    // Probe all baud rates again.
+    _NODE_reset_low_baud_rate_flags();
+    // Cancel incremental scan.
+    node_ctx.scan_state = NODE_SCAN_STATE_IDLE;
     // Add master board to the list.
     NODE_LIST.list[NODE_LIST_DMM_NODE_INDEX].board_id = UNA_BOARD_ID_DMM;
     NODE_LIST.list[NODE_LIST_DMM_NODE_INDEX].address = UNA_NODE_ADDRESS_MASTER;
+    _NODE_reset_link(NODE_LIST_DMM_NODE_INDEX);
     NODE_LIST.count++;
+    _NODE_update_registry();
     // Turn bus interface on.
     POWER_enable(POWER_REQUESTER_ID_NODE, POWER_DOMAIN_RS485, LPTIM_DELAY_MODE_STOP);
     // Scan LBUS nodes.
-    una_at_init = 1;
-    una_at_config.baud_rate = NODE_UNA_AT_BAUD_RATE;
-    una_at_status = UNA_AT_init(&una_at_config);
-    UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
+    status = _NODE_select_protocol(NODE_PROTOCOL_UNA_AT, NODE_UNA_AT_BAUD_RATE_INDEX_DEFAULT);
+    if (status != NODE_SUCCESS) goto errors;
     una_at_status = UNA_AT_scan(&(NODE_LIST.list[NODE_LIST.count]), (NODE_LIST_SIZE - NODE_LIST.count), &node_count);
     UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
-    una_at_status = UNA_AT_de_init();
-    UNA_AT_exit_error(NODE_ERROR_BASE_UNA_AT);
-    una_at_init = 0;
-    // Update count.
-    NODE_LIST.count += node_count;
+    // Update count and negotiate baud rate of each node.
+    for (idx = 0; idx < node_count; idx++) {
+        NODE_LIST.count++;
+        _NODE_update_registry();
+        status = _NODE_negotiate_baud_rate(NODE_LIST.count - 1);
+        if (status != NODE_SUCCESS) goto errors;
+    }
     // Scan R4S8CR nodes.
-    una_r4s8cr_init = 1;
-    una_r4s8cr_status = UNA_R4S8CR_init();
-    UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
-    una_r4s8cr_status = UNA_R4S8CR_scan(&(NODE_LIST.list[NODE_LIST.count]), (NODE_LIST_SIZE - NODE_LIST.count), &node_count);
-    UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
-    una_r4s8cr_status = UNA_R4S8CR_de_init();
-    UNA_R4S8CR_exit_error(NODE_ERROR_BASE_UNA_R4S8CR);
-    una_r4s8cr_init = 0;
-    // Update count.
-    NODE_LIST.count += node_count;
+    status = _NODE_scan_r4s8cr_nodes();
+    if (status != NODE_SUCCESS) goto errors;
 errors:
-    // Force release in case of error.
-    if (una_at_init != 0) {
-        UNA_AT_de_init();
-    }
-    if (una_r4s8cr_init != 0) {
-        UNA_R4S8CR_de_init();
-    }
+    // Release interface if needed.
+    _NODE_end_access();
     // Turn bus interface off.
     POWER_disable(POWER_REQUESTER_ID_NODE, POWER_DOMAIN_RS485);
-    // Read scan period.
-    read_params.node_addr = UNA_NODE_ADDRESS_MASTER;
-    read_params.reg_addr = DMM_REGISTER_ADDRESS_CONFIGURATION_0;
-    read_params.reply_params.type = UNA_REPLY_TYPE_OK;
-    read_params.reply_params.timeout_ms = 0;
-    una_dmm_status = UNA_DMM_read_register(&read_params, &reg_value, &read_status);
-    UNA_DMM_stack_error(ERROR_BASE_NODE + NODE_ERROR_BASE_UNA_DMM);
-    // Check access status.
-    if ((una_dmm_status == UNA_DMM_SUCCESS) && (read_status.all == 0)) {
-        scan_period_seconds = UNA_get_seconds((uint32_t) SWREG_read_field(reg_value, DMM_REGISTER_CONFIGURATION_0_MASK_NODE_SCAN_PERIOD));
-    }
     // Update next scan time.
-    node_ctx.scan_next_time_seconds += scan_period_seconds;
+    _NODE_update_scan_next_time();
     return status;
 }
 
@@ -418,10 +1704,10 @@ errors:
 NODE_status_t NODE_process(void) {
     // Local variables.
     NODE_status_t status = NODE_SUCCESS;
-    // Check scan period.
-    if (RTC_get_uptime_seconds() >= node_ctx.scan_next_time_seconds) {
-        // Perform scan.
-        status = NODE_scan();
+    // Check scan period or pending sweep.
+    if ((RTC_get_uptime_seconds() >= node_ctx.scan_next_time_seconds) || (node_ctx.scan_state != NODE_SCAN_STATE_IDLE)) {
+        // Perform incremental scan.
+        status = _NODE_scan_incremental();
         if (status != NODE_SUCCESS) goto errors;
     }
 errors:
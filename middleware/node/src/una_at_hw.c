@@ -12,6 +12,7 @@
 #endif
 #include "iwdg.h"
 #include "lptim.h"
+#include "node.h"
 #include "una_at.h"
 #include "types.h"
 
@@ -29,6 +30,8 @@ UNA_AT_status_t UNA_AT_HW_delay_milliseconds(uint32_t delay_ms) {
     // Perform delay.
     lptim_status = LPTIM_delay_milliseconds(delay_ms, LPTIM_DELAY_MODE_SLEEP);
     LPTIM_exit_error(UNA_AT_ERROR_BASE_DELAY);
+    // Update node layer statistics.
+    NODE_update_bus_wait_time(delay_ms);
 errors:
     return status;
 }
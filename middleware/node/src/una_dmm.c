@@ -7,6 +7,7 @@
 
 #include "una_dmm.h"
 
+#include "dinfox_registers_flags.h"
 #include "dmm_flags.h"
 #include "dmm_registers.h"
 #include "common_registers.h"
@@ -35,6 +36,22 @@
 #define UNA_DMM_SIGFOX_DL_PERIOD_SECONDS_MAX        604800
 #define UNA_DMM_SIGFOX_DL_PERIOD_SECONDS_DEFAULT    21600
 
+#define UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_MIN       0
+#define UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_MAX       1440
+
+#define UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_MIN       1
+#define UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_MAX       144
+
+#define UNA_DMM_SIGFOX_BUDGET_CONFIGURATION_DEFAULT ((UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT << 16) | (UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT << 0))
+
+#define UNA_DMM_RADIO_NODE_PATTERN_SIZE_DEFAULT             0
+
+#define UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_MAX         100
+#define UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_DEFAULT     0
+
+#define UNA_DMM_RADIO_AGGREGATION_PERIOD_SECONDS_MAX        3600
+#define UNA_DMM_RADIO_AGGREGATION_PERIOD_SECONDS_DEFAULT    0
+
 #ifdef HW1_0
 #define UNA_DMM_HW_VERSION_MAJOR                    1
 #define UNA_DMM_HW_VERSION_MINOR                    0
@@ -57,9 +74,38 @@ typedef struct {
     uint8_t internal_access;
 } UNA_DMM_context_t;
 
+/*** UNA DMM global variables ***/
+
+UNA_register_t UNA_DMM_REGISTER[UNA_DMM_REGISTER_ADDRESS_LAST];
+
 /*** UNA DMM local global variables ***/
 
-static uint32_t UNA_DMM_RAM_REGISTER[DMM_REGISTER_ADDRESS_LAST] = { [0 ... (DMM_REGISTER_ADDRESS_LAST - 1)] = 0x00000000 };
+static const UNA_register_t UNA_DMM_REGISTER_EXTENSION[UNA_DMM_REGISTER_ADDRESS_LAST - DMM_REGISTER_ADDRESS_LAST] = {
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = UNA_NODE_ADDRESS_MASTER, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = UNA_DMM_SIGFOX_BUDGET_CONFIGURATION_DEFAULT, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_ONLY, .reset_value = UNA_REGISTER_RESET_VALUE_STATIC, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+    { .access = UNA_REGISTER_ACCESS_READ_WRITE, .reset_value = UNA_REGISTER_RESET_VALUE_NVM, .error_value = 0x00000000, .timeout_ms = DINFOX_REGISTERS_DEFAULT_TIMEOUT_MS },
+};
+
+static uint32_t UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_LAST] = { [0 ... (UNA_DMM_REGISTER_ADDRESS_LAST - 1)] = 0x00000000 };
 
 static UNA_DMM_context_t una_dmm_ctx = {
     .internal_access = 0
@@ -146,12 +192,63 @@ static void _UNA_DMM_init_register(uint8_t reg_addr, uint32_t* reg_value) {
         SWREG_write_field(reg_value, &unused_mask, UNA_convert_seconds(DMM_SIGFOX_UL_PERIOD_SECONDS), DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_UL_PERIOD);
         SWREG_write_field(reg_value, &unused_mask, UNA_convert_seconds(DMM_SIGFOX_DL_PERIOD_SECONDS), DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_DL_PERIOD);
         break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_CONFIGURATION:
+        SWREG_write_field(reg_value, &unused_mask, UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT, UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_UL_MESSAGES);
+        SWREG_write_field(reg_value, &unused_mask, UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT, UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_DL_MESSAGES);
+        break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_AGGREGATION_CONFIGURATION:
+        SWREG_write_field(reg_value, &unused_mask, UNA_convert_seconds(DMM_RADIO_AGGREGATION_PERIOD_SECONDS), UNA_DMM_REGISTER_RADIO_AGGREGATION_CONFIGURATION_MASK_SAMPLING_PERIOD);
+        break;
 #endif
     default:
         break;
     }
 }
 
+/*******************************************************************/
+static uint32_t _UNA_DMM_saturate_u16(uint32_t value) {
+    // Limit to 16-bits field.
+    return ((value > 0xFFFF) ? 0xFFFF : value);
+}
+
+/*******************************************************************/
+static void _UNA_DMM_refresh_bus_statistics(void) {
+    // Local variables.
+    NODE_statistics_t statistics;
+    UNA_node_address_t node_addr = (UNA_node_address_t) SWREG_read_field(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_CONFIGURATION], UNA_DMM_REGISTER_BUS_STATISTICS_CONFIGURATION_MASK_NODE_ADDR);
+    uint32_t* reg_ptr = NULL;
+    uint32_t unused_mask = 0;
+    uint8_t reg_addr = 0;
+    // Reset registers.
+    for (reg_addr = UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_0; reg_addr <= UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_5; reg_addr++) {
+        UNA_DMM_RAM_REGISTER[reg_addr] = UNA_DMM_REGISTER[reg_addr].error_value;
+    }
+    // Read statistics of the selected node.
+    if (NODE_get_statistics(node_addr, &statistics) != NODE_SUCCESS) goto errors;
+    // Transactions.
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_0]);
+    SWREG_write_field(reg_ptr, &unused_mask, statistics.transaction_count, UNA_DMM_REGISTER_BUS_STATISTICS_0_MASK_TRANSACTION_COUNT);
+    // Timeouts and accesses to unhealthy nodes.
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_1]);
+    SWREG_write_field(reg_ptr, &unused_mask, _UNA_DMM_saturate_u16(statistics.timeout_count), UNA_DMM_REGISTER_BUS_STATISTICS_1_MASK_TIMEOUT_COUNT);
+    SWREG_write_field(reg_ptr, &unused_mask, _UNA_DMM_saturate_u16(statistics.unhealthy_access_count), UNA_DMM_REGISTER_BUS_STATISTICS_1_MASK_UNHEALTHY_ACCESS_COUNT);
+    // Exchanged bytes.
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_2]);
+    SWREG_write_field(reg_ptr, &unused_mask, statistics.byte_count, UNA_DMM_REGISTER_BUS_STATISTICS_2_MASK_BYTE_COUNT);
+    // Bus time.
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_3]);
+    SWREG_write_field(reg_ptr, &unused_mask, statistics.bus_time_ms, UNA_DMM_REGISTER_BUS_STATISTICS_3_MASK_BUS_TIME);
+    // Latency histogram.
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_4]);
+    SWREG_write_field(reg_ptr, &unused_mask, _UNA_DMM_saturate_u16(statistics.latency_histogram[0]), UNA_DMM_REGISTER_BUS_STATISTICS_4_MASK_LATENCY_BIN_0);
+    SWREG_write_field(reg_ptr, &unused_mask, _UNA_DMM_saturate_u16(statistics.latency_histogram[1]), UNA_DMM_REGISTER_BUS_STATISTICS_4_MASK_LATENCY_BIN_1);
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_5]);
+    SWREG_write_field(reg_ptr, &unused_mask, _UNA_DMM_saturate_u16(statistics.latency_histogram[2]), UNA_DMM_REGISTER_BUS_STATISTICS_5_MASK_LATENCY_BIN_2);
+    SWREG_write_field(reg_ptr, &unused_mask, _UNA_DMM_saturate_u16(statistics.latency_histogram[3]), UNA_DMM_REGISTER_BUS_STATISTICS_5_MASK_LATENCY_BIN_3);
+errors:
+    return;
+}
+
 /*******************************************************************/
 static void _UNA_DMM_refresh_register(uint8_t reg_addr) {
     // Local variables.
@@ -168,6 +265,14 @@ static void _UNA_DMM_refresh_register(uint8_t reg_addr) {
     case DMM_REGISTER_ADDRESS_STATUS_1:
         SWREG_write_field(reg_ptr, &unused_mask, (uint32_t) (NODE_LIST.count), DMM_REGISTER_STATUS_1_MASK_NODE_COUNT);
         break;
+    case UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_0:
+    case UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_1:
+    case UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_2:
+    case UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_3:
+    case UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_4:
+    case UNA_DMM_REGISTER_ADDRESS_BUS_STATISTICS_5:
+        _UNA_DMM_refresh_bus_statistics();
+        break;
     default:
         break;
     }
@@ -226,6 +331,72 @@ static UNA_DMM_status_t _UNA_DMM_secure_register(uint8_t reg_addr, uint32_t new_
             status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
         );
         break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_CONFIGURATION:
+        SWREG_secure_field(
+            UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_UL_MESSAGES,,,
+            < UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_MIN,
+            > UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_MAX,
+            UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT,
+            status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
+        );
+        SWREG_secure_field(
+            UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_DL_MESSAGES,,,
+            < UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_MIN,
+            > UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_MAX,
+            UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT,
+            status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
+        );
+        break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_0_CONFIGURATION:
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_1_CONFIGURATION:
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_2_CONFIGURATION:
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_3_CONFIGURATION:
+        SWREG_secure_field(
+            UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_PATTERN_SIZE,,,
+            > UNA_DMM_RADIO_NODE_PATTERN_SIZE_MAX,
+            > UNA_DMM_RADIO_NODE_PATTERN_SIZE_MAX,
+            UNA_DMM_RADIO_NODE_PATTERN_SIZE_DEFAULT,
+            status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
+        );
+        break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_0:
+        SWREG_secure_field(
+            UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_VOLTAGE_RELATIVE,,,
+            > UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_MAX,
+            > UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_MAX,
+            UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_DEFAULT,
+            status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
+        );
+        break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_1:
+        SWREG_secure_field(
+            UNA_DMM_REGISTER_RADIO_DEADBAND_1_MASK_CURRENT_RELATIVE,,,
+            > UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_MAX,
+            > UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_MAX,
+            UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_DEFAULT,
+            status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
+        );
+        break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_2:
+        SWREG_secure_field(
+            UNA_DMM_REGISTER_RADIO_DEADBAND_2_MASK_TEMPERATURE_RELATIVE,,,
+            > UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_MAX,
+            > UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_MAX,
+            UNA_DMM_RADIO_DEADBAND_RELATIVE_PERCENT_DEFAULT,
+            status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
+        );
+        break;
+    case UNA_DMM_REGISTER_ADDRESS_RADIO_AGGREGATION_CONFIGURATION:
+        SWREG_secure_field(
+            UNA_DMM_REGISTER_RADIO_AGGREGATION_CONFIGURATION_MASK_SAMPLING_PERIOD,
+            UNA_get_seconds,
+            UNA_convert_seconds,
+            > UNA_DMM_RADIO_AGGREGATION_PERIOD_SECONDS_MAX,
+            > UNA_DMM_RADIO_AGGREGATION_PERIOD_SECONDS_MAX,
+            UNA_DMM_RADIO_AGGREGATION_PERIOD_SECONDS_DEFAULT,
+            status = UNA_DMM_ERROR_REGISTER_FIELD_VALUE
+        );
+        break;
     default:
         break;
     }
@@ -348,15 +519,19 @@ UNA_DMM_status_t UNA_DMM_init(void) {
     uint8_t reg_addr = 0;
     UNA_access_parameters_t write_params;
     UNA_access_status_t unused_status;
+    // Build registers map.
+    for (reg_addr = 0; reg_addr < UNA_DMM_REGISTER_ADDRESS_LAST; reg_addr++) {
+        UNA_DMM_REGISTER[reg_addr] = (reg_addr < DMM_REGISTER_ADDRESS_LAST) ? DMM_REGISTER[reg_addr] : UNA_DMM_REGISTER_EXTENSION[reg_addr - DMM_REGISTER_ADDRESS_LAST];
+    }
     // Init context.
     una_dmm_ctx.internal_access = 1;
     // Init registers.
-    for (reg_addr = 0; reg_addr < DMM_REGISTER_ADDRESS_LAST; reg_addr++) {
+    for (reg_addr = 0; reg_addr < UNA_DMM_REGISTER_ADDRESS_LAST; reg_addr++) {
         // Check reset value.
-        switch (DMM_REGISTER[reg_addr].reset_value) {
+        switch (UNA_DMM_REGISTER[reg_addr].reset_value) {
         case UNA_REGISTER_RESET_VALUE_STATIC:
             // Init to error value.
-            init_reg_value = DMM_REGISTER[reg_addr].error_value;
+            init_reg_value = UNA_DMM_REGISTER[reg_addr].error_value;
             break;
 #ifndef DMM_NVM_FACTORY_RESET
         case UNA_REGISTER_RESET_VALUE_NVM:
@@ -376,7 +551,7 @@ UNA_DMM_status_t UNA_DMM_init(void) {
         write_params.node_addr = UNA_NODE_ADDRESS_MASTER;
         write_params.reg_addr = reg_addr;
         write_params.reply_params.type = UNA_REPLY_TYPE_NONE;
-        write_params.reply_params.timeout_ms = DMM_REGISTER[reg_addr].timeout_ms;
+        write_params.reply_params.timeout_ms = UNA_DMM_REGISTER[reg_addr].timeout_ms;
         // Write initial value.
         una_dmm_status = UNA_DMM_write_register(&write_params, init_reg_value, UNA_REGISTER_MASK_ALL, &unused_status);
         UNA_DMM_stack_error(ERROR_BASE_UNA_DMM);
@@ -408,13 +583,13 @@ UNA_DMM_status_t UNA_DMM_write_register(UNA_access_parameters_t* write_params, u
        goto errors;
     }
     // Check register address.
-    if (reg_addr >= DMM_REGISTER_ADDRESS_LAST) {
+    if (reg_addr >= UNA_DMM_REGISTER_ADDRESS_LAST) {
         // Act as a slave.
         (*write_status).error_received = 1;
         goto errors;
     }
     // Check access.
-    if ((una_dmm_ctx.internal_access == 0) && (DMM_REGISTER[reg_addr].access == UNA_REGISTER_ACCESS_READ_ONLY)) {
+    if ((una_dmm_ctx.internal_access == 0) && (UNA_DMM_REGISTER[reg_addr].access == UNA_REGISTER_ACCESS_READ_ONLY)) {
         // Act as a slave.
         (*write_status).error_received = 1;
         goto errors;
@@ -428,7 +603,7 @@ UNA_DMM_status_t UNA_DMM_write_register(UNA_access_parameters_t* write_params, u
     una_dmm_status = _UNA_DMM_secure_register(reg_addr, UNA_DMM_RAM_REGISTER[reg_addr], &safe_reg_mask, &(UNA_DMM_RAM_REGISTER[reg_addr]));
     UNA_DMM_stack_error(ERROR_BASE_UNA_DMM);
     // Store value in NVM if needed.
-    if (DMM_REGISTER[reg_addr].reset_value == UNA_REGISTER_RESET_VALUE_NVM) {
+    if (UNA_DMM_REGISTER[reg_addr].reset_value == UNA_REGISTER_RESET_VALUE_NVM) {
         una_dmm_status = _UNA_DMM_store_register(reg_addr);
         UNA_DMM_stack_error(ERROR_BASE_UNA_DMM);
     }
@@ -465,7 +640,7 @@ UNA_DMM_status_t UNA_DMM_read_register(UNA_access_parameters_t* read_params, uin
         goto errors;
     }
     // Check register address.
-    if (reg_addr >= DMM_REGISTER_ADDRESS_LAST) {
+    if (reg_addr >= UNA_DMM_REGISTER_ADDRESS_LAST) {
         // Act as a slave.
         (*read_status).error_received = 1;
         goto errors;
@@ -476,3 +651,17 @@ UNA_DMM_status_t UNA_DMM_read_register(UNA_access_parameters_t* read_params, uin
 errors:
     return status;
 }
+
+/*******************************************************************/
+void UNA_DMM_set_radio_budget_status(uint32_t ul_message_count, uint32_t dl_message_count, uint32_t ul_effective_period_seconds) {
+    // Local variables.
+    uint32_t* reg_ptr = NULL;
+    uint32_t unused_mask = 0;
+    // Messages count.
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_STATUS_0]);
+    SWREG_write_field(reg_ptr, &unused_mask, _UNA_DMM_saturate_u16(ul_message_count), UNA_DMM_REGISTER_RADIO_BUDGET_STATUS_0_MASK_UL_COUNT);
+    SWREG_write_field(reg_ptr, &unused_mask, ((dl_message_count > 0xFF) ? 0xFF : dl_message_count), UNA_DMM_REGISTER_RADIO_BUDGET_STATUS_0_MASK_DL_COUNT);
+    // Effective uplink period.
+    reg_ptr = &(UNA_DMM_RAM_REGISTER[UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_STATUS_1]);
+    SWREG_write_field(reg_ptr, &unused_mask, ul_effective_period_seconds, UNA_DMM_REGISTER_RADIO_BUDGET_STATUS_1_MASK_UL_PERIOD);
+}
@@ -9,10 +9,21 @@
 #define __RADIO_H__
 
 #include "error.h"
+#include "lptim.h"
 #include "node.h"
+#include "nvm.h"
 #include "types.h"
 #include "una.h"
 
+/*** RADIO macros ***/
+
+#define RADIO_UL_DEADBAND_SLOT_COUNT            2
+#define RADIO_UL_DEADBAND_FIELD_COUNT_MAX       8
+#define RADIO_UL_DEADBAND_PAYLOAD_TYPE_NONE     0xFF
+#define RADIO_UL_REFERENCE_PAYLOAD_TYPE_NONE    0xFF
+
+#define RADIO_ACTION_TIME_NONE                  0xFFFFFFFF
+
 /*!******************************************************************
  * \enum RADIO_status_t
  * \brief Radio driver error codes.
@@ -26,6 +37,7 @@ typedef enum {
     RADIO_ERROR_MODEM_UL_PAYLOAD,
     RADIO_ERROR_MODEL_UL_CONFIGURATION,
     RADIO_ERROR_MODEM_UL_TRANSMISSION,
+    RADIO_ERROR_MODEM_UL_BUDGET,
     RADIO_ERROR_MODEM_DL_MESSAGE_STATUS,
     RADIO_ERROR_MODEM_DL_PAYLOAD,
     RADIO_ERROR_MODEM_DL_BIDIRECTIONAL_MC,
@@ -40,20 +52,56 @@ typedef enum {
     RADIO_ERROR_ACTION_LIST_INDEX,
     RADIO_ERROR_ACTION_NODE_ADDRESS,
     RADIO_ERROR_ACTION_READ_ACCESS,
+    RADIO_ERROR_UL_QUEUE_PRIORITY,
+    RADIO_ERROR_UL_QUEUE_FULL,
+    RADIO_ERROR_CODEC_SCHEMA,
+    RADIO_ERROR_MODEM_UL_COMPLETION,
     // Low level drivers errors.
     RADIO_ERROR_BASE_NODE = ERROR_BASE_STEP,
+    RADIO_ERROR_BASE_NVM = (RADIO_ERROR_BASE_NODE + NODE_ERROR_BASE_LAST),
+    RADIO_ERROR_BASE_LPTIM = (RADIO_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
     // Last base value.
-    RADIO_ERROR_BASE_LAST = (RADIO_ERROR_BASE_NODE + NODE_ERROR_BASE_LAST)
+    RADIO_ERROR_BASE_LAST = (RADIO_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST)
 } RADIO_status_t;
 
+/*!******************************************************************
+ * \enum RADIO_deadband_t
+ * \brief Last sent values of a node payload type.
+ *******************************************************************/
+typedef struct {
+    uint8_t payload_type;
+    uint32_t time_seconds;
+    uint16_t value[RADIO_UL_DEADBAND_FIELD_COUNT_MAX];
+} RADIO_deadband_t;
+
+/*!******************************************************************
+ * \enum RADIO_ul_reference_t
+ * \brief Reference fields of delta encoded uplink payloads.
+ *******************************************************************/
+typedef struct {
+    uint8_t payload_type;
+    uint8_t delta_count;
+    uint8_t transmitted_flag;
+    uint16_t value[RADIO_UL_DEADBAND_FIELD_COUNT_MAX];
+} RADIO_ul_reference_t;
+
 /*!******************************************************************
  * \enum RADIO_node_t
  * \brief Radio node structure.
  *******************************************************************/
 typedef struct {
     UNA_node_t* node;
+    UNA_node_address_t node_addr;
     uint8_t payload_type_counter;
     uint8_t error_stack_payload_counter;
+    uint32_t ul_deadline_seconds;
+    uint8_t ul_event_pending;
+    uint32_t ul_period_seconds;
+    uint32_t ul_next_time_seconds;
+    uint32_t ul_pattern;
+    uint8_t ul_pattern_size;
+    RADIO_deadband_t ul_deadband[RADIO_UL_DEADBAND_SLOT_COUNT];
+    RADIO_ul_reference_t ul_reference;
 } RADIO_node_t;
 
 /*!******************************************************************
@@ -70,7 +118,7 @@ typedef struct {
  * \brief Radio node action structure.
  *******************************************************************/
 typedef struct {
-    UNA_node_t* node;
+    UNA_node_address_t node_addr;
     uint32_t downlink_hash;
     uint32_t timestamp_seconds;
     uint8_t reg_addr;
@@ -108,6 +156,24 @@ RADIO_status_t RADIO_de_init(void);
  *******************************************************************/
 RADIO_status_t RADIO_process(void);
 
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_execute_actions(uint32_t time_seconds)
+ * \brief Execute the pending downlink actions which are due at a given time.
+ * \param[in]   time_seconds: Uptime at which the actions are executed.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_execute_actions(uint32_t time_seconds);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_get_next_action_time(uint32_t* next_action_time_seconds)
+ * \brief Get the uptime at which the earliest pending downlink action is due.
+ * \param[in]   none
+ * \param[out]  next_action_time_seconds: Pointer to the action due time (RADIO_ACTION_TIME_NONE if no action is pending).
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_get_next_action_time(uint32_t* next_action_time_seconds);
+
 /*******************************************************************/
 #define RADIO_exit_error(base) { ERROR_check_exit(radio_status, RADIO_SUCCESS, base) }
 
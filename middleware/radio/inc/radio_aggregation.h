@@ -0,0 +1,52 @@
+/*
+ * radio_aggregation.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __RADIO_AGGREGATION_H__
+#define __RADIO_AGGREGATION_H__
+
+#include "radio.h"
+#include "types.h"
+
+/*** RADIO AGGREGATION functions ***/
+
+/*!******************************************************************
+ * \fn void RADIO_AGGREGATION_init(void)
+ * \brief Reset all aggregation slots.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void RADIO_AGGREGATION_init(void);
+
+/*!******************************************************************
+ * \fn void RADIO_AGGREGATION_set_sampling_period(uint32_t sampling_period_seconds)
+ * \brief Set the nodes data sampling period.
+ * \param[in]   sampling_period_seconds: Sampling period in seconds (0 to disable aggregation).
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void RADIO_AGGREGATION_set_sampling_period(uint32_t sampling_period_seconds);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_AGGREGATION_process(uint32_t uptime_seconds)
+ * \brief Sample the aggregated nodes data if the sampling period is elapsed.
+ * \param[in]   uptime_seconds: Current uptime.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_AGGREGATION_process(uint32_t uptime_seconds);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_AGGREGATION_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload)
+ * \brief Build node summary uplink payload.
+ * \param[in]   radio_node: Node to process.
+ * \param[out]  node_payload: Pointer to the node uplink payload (size is 0 when the regular payload has to be used).
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_AGGREGATION_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload);
+
+#endif /* __RADIO_AGGREGATION_H__ */
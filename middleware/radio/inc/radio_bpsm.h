@@ -22,4 +22,13 @@
  *******************************************************************/
 RADIO_status_t RADIO_BPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload);
 
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_BPSM_check_schemas(void)
+ * \brief Check the schemas of the BPSM payloads.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_BPSM_check_schemas(void);
+
 #endif /* __RADIO_BPSM_H__ */
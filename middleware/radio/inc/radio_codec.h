@@ -0,0 +1,71 @@
+/*
+ * radio_codec.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __RADIO_CODEC_H__
+#define __RADIO_CODEC_H__
+
+#include "radio.h"
+#include "types.h"
+
+/*** RADIO CODEC structures ***/
+
+/*!******************************************************************
+ * \enum RADIO_CODEC_field_t
+ * \brief Frame field descriptor.
+ *******************************************************************/
+typedef struct {
+    uint8_t field_index;
+    uint8_t offset_bits;
+    uint8_t size_bits;
+} RADIO_CODEC_field_t;
+
+/*!******************************************************************
+ * \enum RADIO_CODEC_schema_t
+ * \brief Frame schema structure (fields are big-endian, offset 0 being the MSB of the first byte).
+ *******************************************************************/
+typedef struct {
+    const RADIO_CODEC_field_t* field_list;
+    uint8_t field_count;
+    uint8_t frame_size_bytes;
+} RADIO_CODEC_schema_t;
+
+/*** RADIO CODEC macros ***/
+
+#define RADIO_CODEC_SCHEMA(field_list, frame_size_bytes) { (field_list), (sizeof(field_list) / sizeof(RADIO_CODEC_field_t)), (frame_size_bytes) }
+
+/*** RADIO CODEC functions ***/
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_CODEC_check_schema(const RADIO_CODEC_schema_t* schema)
+ * \brief Check the fields bounds of a frame schema.
+ * \param[in]   schema: Pointer to the frame schema.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_CODEC_check_schema(const RADIO_CODEC_schema_t* schema);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_CODEC_pack(const RADIO_CODEC_schema_t* schema, uint32_t* field_value, uint8_t* frame)
+ * \brief Build a frame from its fields values (the schema must have been checked with RADIO_CODEC_check_schema()).
+ * \param[in]   schema: Pointer to the frame schema.
+ * \param[in]   field_value: Fields values, indexed by the field index of the schema.
+ * \param[out]  frame: Pointer to the frame (bits which are not described by the schema are cleared).
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_CODEC_pack(const RADIO_CODEC_schema_t* schema, uint32_t* field_value, uint8_t* frame);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_CODEC_unpack(const RADIO_CODEC_schema_t* schema, uint8_t* frame, uint32_t* field_value)
+ * \brief Extract the fields values of a frame (the schema must have been checked with RADIO_CODEC_check_schema()).
+ * \param[in]   schema: Pointer to the frame schema.
+ * \param[in]   frame: Pointer to the frame.
+ * \param[out]  field_value: Fields values, indexed by the field index of the schema (other entries are not modified).
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_CODEC_unpack(const RADIO_CODEC_schema_t* schema, uint8_t* frame, uint32_t* field_value);
+
+#endif /* __RADIO_CODEC_H__ */
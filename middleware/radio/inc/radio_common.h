@@ -11,11 +11,50 @@
 #include "radio.h"
 #include "types.h"
 
+/*** RADIO COMMON macros ***/
+
+// Uplink payloads are decoded from the board ID of the header and from their size.
+// The startup and error stack payloads can be sent by any node and have no marker: no other payload may use their sizes.
+#define RADIO_COMMON_UL_PAYLOAD_STARTUP_SIZE            8
+#define RADIO_COMMON_UL_PAYLOAD_ERROR_STACK_SIZE        10
+// The other common payloads start with a 4-bits marker, which distinguishes them from a board payload of the same size.
+#define RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_MARKER       0b1011
+#define RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_SIZE_MAX     9
+#define RADIO_COMMON_UL_PAYLOAD_COMPACT_MARKER          0b1100
+#define RADIO_COMMON_UL_PAYLOAD_AGGREGATION_MARKER      0b1101
+#define RADIO_COMMON_UL_PAYLOAD_AGGREGATION_SIZE        9
+#define RADIO_COMMON_UL_PAYLOAD_ALARM_MARKER            0b1110
+#define RADIO_COMMON_UL_PAYLOAD_ALARM_SIZE              6
+
+/*** RADIO COMMON structures ***/
+
+/*!******************************************************************
+ * \enum RADIO_COMMON_data_type_t
+ * \brief Payload field data types used for deadband reporting.
+ *******************************************************************/
+typedef enum {
+    RADIO_COMMON_DATA_TYPE_VOLTAGE = 0,
+    RADIO_COMMON_DATA_TYPE_CURRENT,
+    RADIO_COMMON_DATA_TYPE_TEMPERATURE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_LAST
+} RADIO_COMMON_data_type_t;
+
+/*!******************************************************************
+ * \enum RADIO_COMMON_compact_encoding_t
+ * \brief Compact payloads encodings.
+ *******************************************************************/
+typedef enum {
+    RADIO_COMMON_COMPACT_ENCODING_ABSOLUTE = 0,
+    RADIO_COMMON_COMPACT_ENCODING_DELTA,
+    RADIO_COMMON_COMPACT_ENCODING_LAST
+} RADIO_COMMON_compact_encoding_t;
+
 /*** RADIO COMMON functions ***/
 
 /*!******************************************************************
  * \fn RADIO_status_t RADIO_COMMON_check_event_driven_payloads(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload, uint32_t* node_registers)
- * \brief Check common flags and build associated payloads.
+ * \brief Check common flags, build associated payloads and update the event pending flag of the node.
  * \param[in]   radio_node: Node to process.
  * \param[out]  node_registers: Pointer to the node registers.
  * \param[out]  node_payload: Pointer to the node uplink payload.
@@ -24,12 +63,100 @@
 RADIO_status_t RADIO_COMMON_check_event_driven_payloads(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload, uint32_t* node_registers);
 
 /*!******************************************************************
- * \fn RADIO_status_t RADIO_COMMON_build_ul_node_payload_action_log(RADIO_node_action_t* node_action, RADIO_ul_payload_t* node_payload)
- * \brief Build common action log uplink payload.
- * \param[in]   node_action: Pointer to the action to log.
+ * \fn RADIO_status_t RADIO_COMMON_get_ul_payload_type(RADIO_node_t* radio_node, const uint8_t* default_pattern, uint8_t default_pattern_size, uint8_t payload_type_last, uint8_t* payload_type)
+ * \brief Get the next payload type of a node, from its runtime pattern if configured or from the default one.
+ * \param[in]   radio_node: Node to process.
+ * \param[in]   default_pattern: Default payload types pattern of the board.
+ * \param[in]   default_pattern_size: Number of entries in the default pattern.
+ * \param[in]   payload_type_last: Number of payload types of the board.
+ * \param[out]  payload_type: Pointer to the payload type to build.
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_COMMON_get_ul_payload_type(RADIO_node_t* radio_node, const uint8_t* default_pattern, uint8_t default_pattern_size, uint8_t payload_type_last, uint8_t* payload_type);
+
+/*!******************************************************************
+ * \fn void RADIO_COMMON_increment_ul_payload_type(RADIO_node_t* radio_node, uint8_t default_pattern_size)
+ * \brief Switch to the next entry of the node payload types pattern.
+ * \param[in]   radio_node: Node to process.
+ * \param[in]   default_pattern_size: Number of entries in the default pattern.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void RADIO_COMMON_increment_ul_payload_type(RADIO_node_t* radio_node, uint8_t default_pattern_size);
+
+/*!******************************************************************
+ * \fn void RADIO_COMMON_set_deadband_configuration(uint32_t reg_deadband_0, uint32_t reg_deadband_1, uint32_t reg_deadband_2)
+ * \brief Set deadbands and heartbeat period from DMM registers.
+ * \param[in]   reg_deadband_0: Voltage deadbands and heartbeat period register.
+ * \param[in]   reg_deadband_1: Current deadbands register.
+ * \param[in]   reg_deadband_2: Temperature deadbands register.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void RADIO_COMMON_set_deadband_configuration(uint32_t reg_deadband_0, uint32_t reg_deadband_1, uint32_t reg_deadband_2);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_COMMON_check_deadband(RADIO_node_t* radio_node, uint8_t payload_type, const RADIO_COMMON_data_type_t* data_type_list, uint32_t* field_list, uint8_t field_list_size, uint8_t* send_required)
+ * \brief Compare payload fields with the last sent ones and update them if the payload has to be sent.
+ * \param[in]   radio_node: Node to process.
+ * \param[in]   payload_type: Node payload type.
+ * \param[in]   data_type_list: Data type of each field.
+ * \param[in]   field_list: UNA representation of each field.
+ * \param[in]   field_list_size: Number of fields.
+ * \param[out]  send_required: Pointer to the flag indicating if the payload has to be sent.
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_COMMON_check_deadband(RADIO_node_t* radio_node, uint8_t payload_type, const RADIO_COMMON_data_type_t* data_type_list, uint32_t* field_list, uint8_t field_list_size, uint8_t* send_required);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_COMMON_add_ul_node_payload_action_log(RADIO_node_action_t* node_action, RADIO_ul_payload_t* node_payload, uint8_t payload_size_max)
+ * \brief Append an action result to a common action log uplink payload (the header is built when the payload is empty, the startup and error stack payload sizes are never used).
+ * \param[in]   node_action: Pointer to the executed action.
+ * \param[in]   payload_size_max: Maximum size of the node uplink payload.
+ * \param[out]  node_payload: Pointer to the node uplink payload (only actions of the same downlink must be appended).
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_COMMON_add_ul_node_payload_action_log(RADIO_node_action_t* node_action, RADIO_ul_payload_t* node_payload, uint8_t payload_size_max);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_COMMON_build_ul_node_payload_alarm(uint8_t rule_index, uint8_t reg_addr, uint32_t reg_value, RADIO_ul_payload_t* node_payload)
+ * \brief Build common threshold alarm uplink payload.
+ * \param[in]   rule_index: Index of the violated alarm rule.
+ * \param[in]   reg_addr: Address of the watched register.
+ * \param[in]   reg_value: Value of the watched register.
  * \param[out]  node_payload: Pointer to the node uplink payload.
  * \retval      Function execution status.
  *******************************************************************/
-RADIO_status_t RADIO_COMMON_build_ul_node_payload_action_log(RADIO_node_action_t* node_action, RADIO_ul_payload_t* node_payload);
+RADIO_status_t RADIO_COMMON_build_ul_node_payload_alarm(uint8_t rule_index, uint8_t reg_addr, uint32_t reg_value, RADIO_ul_payload_t* node_payload);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_COMMON_check_schemas(void)
+ * \brief Check the schemas of the common payloads.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_COMMON_check_schemas(void);
+
+/*!******************************************************************
+ * \fn uint8_t RADIO_COMMON_get_compact_header(RADIO_COMMON_compact_encoding_t encoding)
+ * \brief Get the header byte of compact payloads (marker, format version and encoding).
+ * \param[in]   encoding: Encoding of the payload fields.
+ * \param[out]  none
+ * \retval      Compact payload header byte.
+ *******************************************************************/
+uint8_t RADIO_COMMON_get_compact_header(RADIO_COMMON_compact_encoding_t encoding);
+
+/*!******************************************************************
+ * \fn uint32_t RADIO_COMMON_get_compact_field(RADIO_COMMON_data_type_t data_type, uint32_t value, int32_t lsb, uint8_t size_bits)
+ * \brief Quantize a UNA field on a reduced number of bits.
+ * \param[in]   data_type: Data type of the field.
+ * \param[in]   value: UNA representation of the field.
+ * \param[in]   lsb: Resolution of the compact field (in mV, uA or tenth of degrees).
+ * \param[in]   size_bits: Size of the compact field (signed data types use offset binary).
+ * \param[out]  none
+ * \retval      Compact field value (all bits set if the value is unknown).
+ *******************************************************************/
+uint32_t RADIO_COMMON_get_compact_field(RADIO_COMMON_data_type_t data_type, uint32_t value, int32_t lsb, uint8_t size_bits);
 
 #endif /* __RADIO_COMMON_H__ */
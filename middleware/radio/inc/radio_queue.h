@@ -0,0 +1,94 @@
+/*
+ * radio_queue.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __RADIO_QUEUE_H__
+#define __RADIO_QUEUE_H__
+
+#include "radio.h"
+#include "types.h"
+
+/*** RADIO QUEUE structures ***/
+
+/*!******************************************************************
+ * \enum RADIO_QUEUE_priority_t
+ * \brief Stored uplink frames priorities.
+ *******************************************************************/
+typedef enum {
+    RADIO_QUEUE_PRIORITY_ROUTINE = 0,
+    RADIO_QUEUE_PRIORITY_EVENT,
+    RADIO_QUEUE_PRIORITY_ALARM,
+    RADIO_QUEUE_PRIORITY_LAST
+} RADIO_QUEUE_priority_t;
+
+/*!******************************************************************
+ * \enum RADIO_QUEUE_frame_t
+ * \brief Stored uplink frame structure.
+ *******************************************************************/
+typedef struct {
+    uint8_t* ul_payload;
+    uint8_t ul_payload_size;
+    RADIO_QUEUE_priority_t priority;
+} RADIO_QUEUE_frame_t;
+
+/*** RADIO QUEUE functions ***/
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_QUEUE_init(void)
+ * \brief Load stored uplink frames from NVM.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_QUEUE_init(void);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_QUEUE_push(RADIO_QUEUE_frame_t* frame)
+ * \brief Store an uplink frame (the oldest frame of lowest priority is evicted when the queue is full).
+ * \param[in]   frame: Pointer to the frame to store.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_QUEUE_push(RADIO_QUEUE_frame_t* frame);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_QUEUE_peek(RADIO_QUEUE_frame_t* frame)
+ * \brief Get the next frame to send (highest priority first, then oldest).
+ * \param[in]   none
+ * \param[out]  frame: Pointer to the frame (payload size is 0 if the queue is empty).
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_QUEUE_peek(RADIO_QUEUE_frame_t* frame);
+
+/*!******************************************************************
+ * \fn void RADIO_QUEUE_pop(void)
+ * \brief Remove the frame returned by the last peek operation.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void RADIO_QUEUE_pop(void);
+
+/*!******************************************************************
+ * \fn uint8_t RADIO_QUEUE_get_count(void)
+ * \brief Get the number of stored frames.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Number of stored frames.
+ *******************************************************************/
+uint8_t RADIO_QUEUE_get_count(void);
+
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_QUEUE_flush(uint32_t uptime_seconds, uint8_t force_flag)
+ * \brief Write modified queue entries in NVM (batched to limit memory wear).
+ * \param[in]   uptime_seconds: Current uptime.
+ * \param[in]   force_flag: Write entries whatever the batching state if non-zero.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_QUEUE_flush(uint32_t uptime_seconds, uint8_t force_flag);
+
+#endif /* __RADIO_QUEUE_H__ */
@@ -33,9 +33,18 @@ typedef struct {
  *******************************************************************/
 RADIO_status_t RADIO_UHFM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload);
 
+/*!******************************************************************
+ * \fn RADIO_status_t RADIO_UHFM_check_schemas(void)
+ * \brief Check the schemas of the UHFM payloads.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+RADIO_status_t RADIO_UHFM_check_schemas(void);
+
 /*!******************************************************************
  * \fn RADIO_status_t RADIO_UHFM_send_ul_message(UNA_node_t* uhfm_node, UHFM_ul_message_t* ul_message)
- * \brief Send Sigfox message with UHFM node.
+ * \brief Start Sigfox message transmission with UHFM node (completion is awaited on next modem access).
  * \param[in]   node: Pointer to the UHFM node to use.
  * \param[in]   ul_message: Pointer to the uplink message to send.
  * \param[out]  none
@@ -44,23 +53,23 @@ RADIO_status_t RADIO_UHFM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
 RADIO_status_t RADIO_UHFM_send_ul_message(UNA_node_t* uhfm_node, UHFM_ul_message_t* ul_message);
 
 /*!******************************************************************
- * \fn RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payload_available, uint8_t* dl_payload)
- * \brief Get last downlink payload received by UHFM node.
+ * \fn RADIO_status_t RADIO_UHFM_wait_completion(UNA_node_t* uhfm_node)
+ * \brief Wait for the end of the current UHFM node transmission (direct return if the modem is idle).
  * \param[in]   node: Pointer to the UHFM node to use.
- * \param[out]  dl_payload: Pointer to the downlink payload.
- * \param[out]  dl_payload_available: Pointer to the data availability flag.
+ * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payload_available, uint8_t* dl_payload);
+RADIO_status_t RADIO_UHFM_wait_completion(UNA_node_t* uhfm_node);
 
 /*!******************************************************************
- * \fn RADIO_status_t RADIO_UHFM_get_last_bidirectional_mc(UNA_node_t* uhfm_node, uint32_t* last_bidirectional_mc)
- * \brief Get last message counter used by UHFM node.
+ * \fn RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payload_available, uint8_t* dl_payload, uint32_t* last_bidirectional_mc)
+ * \brief Get last downlink payload received by UHFM node and the associated message counter.
  * \param[in]   node: Pointer to the UHFM node to use.
- * \param[out]  last_bidirectional_mc: Pointer that will contain the message counter.
- * \param[out]  none
+ * \param[out]  dl_payload_available: Pointer to the data availability flag.
+ * \param[out]  dl_payload: Pointer to the downlink payload.
+ * \param[out]  last_bidirectional_mc: Pointer that will contain the last bidirectional message counter.
  * \retval      Function execution status.
  *******************************************************************/
-RADIO_status_t RADIO_UHFM_get_last_bidirectional_mc(UNA_node_t* uhfm_node, uint32_t* last_bidirectional_mc);
+RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payload_available, uint8_t* dl_payload, uint32_t* last_bidirectional_mc);
 
 #endif /* __RADIO_UHFM_H__ */
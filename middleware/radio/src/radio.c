@@ -12,15 +12,19 @@
 #include "error.h"
 #include "error_base.h"
 #include "dmm_registers.h"
+#include "mpmcm_registers.h"
 #include "node.h"
+#include "radio_aggregation.h"
 #include "radio_bcm.h"
 #include "radio_bpsm.h"
+#include "radio_codec.h"
 #include "radio_common.h"
 #include "radio_ddrm.h"
 #include "radio_dmm.h"
 #include "radio_gpsm.h"
 #include "radio_lvrm.h"
 #include "radio_mpmcm.h"
+#include "radio_queue.h"
 #include "radio_sm.h"
 #include "radio_r4s8cr.h"
 #include "radio_uhfm.h"
@@ -29,6 +33,7 @@
 #include "types.h"
 #include "uhfm_registers.h"
 #include "una.h"
+#include "una_dmm.h"
 
 /*** RADIO local macros ***/
 
@@ -36,24 +41,57 @@
 #define RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES        (UHFM_UL_PAYLOAD_MAX_SIZE_BYTES - RADIO_UL_PAYLOAD_HEADER_SIZE_BYTES)
 #define RADIO_UL_PAYLOAD_TYPE_COUNTER_ERROR_VALUE   0xFF
 
-#define RADIO_DL_HASH_ERROR_VALUE                   0xFFFF
+#define RADIO_UL_PACKED_FRAME_MARKER                0xFF
+#define RADIO_UL_PACKED_FRAME_MARKER_SIZE_BYTES     1
+#define RADIO_UL_PACKED_RECORD_HEADER_SIZE_BYTES    2
+
 #define RADIO_DL_ACCESS_STATUS_ERROR_VALUE          0xFF
 
 #define RADIO_ACTION_LIST_SIZE                      32
 
 #define RADIO_UL_LOOP_MAX                           5
+#define RADIO_UL_SCHEDULE_SIZE                      (RADIO_UL_LOOP_MAX + 1)
+#define RADIO_UL_FRESHNESS_ROUTINE_SECONDS          3600
+#define RADIO_UL_FRESHNESS_POWER_SECONDS            900
+#define RADIO_UL_NODE_PERIOD_SECONDS_MIN            60
+
+#define RADIO_BUDGET_WINDOW_SECONDS                 86400
+#define RADIO_BUDGET_HISTORY_SLOT_SECONDS           3600
+#define RADIO_BUDGET_HISTORY_SIZE                   (RADIO_BUDGET_WINDOW_SECONDS / RADIO_BUDGET_HISTORY_SLOT_SECONDS)
+
+#define RADIO_UL_QUEUE_DRAIN_COUNT_MAX              2
+#define RADIO_UL_QUEUE_BUDGET_RESERVE_MESSAGES      2
+
+#define RADIO_ALARM_RULE_COUNT                      (sizeof(RADIO_ALARM_RULE) / sizeof(RADIO_alarm_rule_t))
+#define RADIO_ALARM_RULE_COUNT_MAX                  8
+#define RADIO_ALARM_RATE_LIMIT_SECONDS              3600
+#define RADIO_ALARM_STORAGE_VOLTAGE_THRESHOLD_MV    1500
+#define RADIO_ALARM_STORAGE_VOLTAGE_HYSTERESIS_MV   200
 
 /*** RADIO local structures ***/
 
 /*******************************************************************/
-typedef union {
-    uint8_t frame[UHFM_UL_PAYLOAD_MAX_SIZE_BYTES];
-    struct {
-        unsigned node_addr :8;
-        unsigned board_id :8;
-        uint8_t node_payload[RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES];
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} RADIO_ul_payload_format_t;
+typedef enum {
+    RADIO_UL_HEADER_FIELD_NODE_ADDR = 0,
+    RADIO_UL_HEADER_FIELD_BOARD_ID,
+    RADIO_UL_HEADER_FIELD_LAST
+} RADIO_ul_header_field_t;
+
+/*******************************************************************/
+// Packed frame format: marker byte followed by records (node address, board ID and payload size nibbles, node payload).
+typedef enum {
+    RADIO_UL_RECORD_FIELD_NODE_ADDR = 0,
+    RADIO_UL_RECORD_FIELD_BOARD_ID,
+    RADIO_UL_RECORD_FIELD_NODE_PAYLOAD_SIZE,
+    RADIO_UL_RECORD_FIELD_LAST
+} RADIO_ul_record_field_t;
+
+/*******************************************************************/
+typedef struct {
+    uint8_t frame[RADIO_UL_PACKED_FRAME_MARKER_SIZE_BYTES + RADIO_UL_PACKED_RECORD_HEADER_SIZE_BYTES + UHFM_UL_PAYLOAD_MAX_SIZE_BYTES];
+    uint8_t size;
+    uint8_t record_count;
+} RADIO_ul_packed_frame_t;
 
 /*******************************************************************/
 typedef RADIO_status_t (*RADIO_build_ul_node_payload_t)(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload);
@@ -75,87 +113,95 @@ typedef enum {
 } RADIO_dl_op_code_t;
 
 /*******************************************************************/
-typedef union {
-    uint8_t frame[UHFM_DL_PAYLOAD_SIZE_BYTES];
-    struct {
-        unsigned op_code :8;
-        union {
-            struct {
-                unsigned node_addr :8;
-                unsigned reg_addr :8;
-                unsigned unused_0 :32;
-                unsigned unused_1 :8;
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) single_full_read;
-            struct {
-                unsigned node_addr :8;
-                unsigned reg_addr :8;
-                unsigned reg_value :32;
-                unsigned duration :8; // Unused in single.
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) full_write;
-            struct {
-                unsigned node_addr :8;
-                unsigned reg_addr :8;
-                unsigned reg_mask :16;
-                unsigned reg_value :16;
-                unsigned duration :8; // Unused in single.
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) masked_write;
-            struct {
-                unsigned node_addr :8;
-                unsigned reg_addr :8;
-                unsigned reg_value_1 :16;
-                unsigned reg_value_2 :16;
-                unsigned duration :8;
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) successive_full_write;
-            struct {
-                unsigned node_addr :8;
-                unsigned reg_addr :8;
-                unsigned reg_mask :8;
-                unsigned reg_value_1 :8;
-                unsigned reg_value_2 :8;
-                unsigned duration :8;
-                unsigned unused :8;
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) successive_masked_write;
-            struct {
-                unsigned node_addr :8;
-                unsigned reg_1_addr :8;
-                unsigned reg_1_value :16;
-                unsigned reg_2_addr :8;
-                unsigned reg_2_value :16;
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) dual_full_write;
-            struct {
-                unsigned node_addr :8;
-                unsigned reg_1_addr :8;
-                unsigned reg_1_value :8;
-                unsigned reg_2_addr :8;
-                unsigned reg_2_value :8;
-                unsigned reg_3_addr :8;
-                unsigned reg_3_value :8;
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) triple_full_write;
-            struct {
-                unsigned node_1_addr :8;
-                unsigned reg_1_addr :8;
-                unsigned reg_1_value :8;
-                unsigned node_2_addr :8;
-                unsigned reg_2_addr :8;
-                unsigned reg_2_value :8;
-                unsigned unused :8;
-            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) dual_node_write;
-        };
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} RADIO_dl_payload_t;
+typedef enum {
+    RADIO_DL_FIELD_OP_CODE = 0,
+    RADIO_DL_FIELD_NODE_ADDR,
+    RADIO_DL_FIELD_REG_ADDR,
+    RADIO_DL_FIELD_REG_VALUE,
+    RADIO_DL_FIELD_REG_MASK,
+    RADIO_DL_FIELD_DURATION,
+    RADIO_DL_FIELD_NODE_2_ADDR,
+    RADIO_DL_FIELD_REG_2_ADDR,
+    RADIO_DL_FIELD_REG_2_VALUE,
+    RADIO_DL_FIELD_REG_3_ADDR,
+    RADIO_DL_FIELD_REG_3_VALUE,
+    RADIO_DL_FIELD_LAST
+} RADIO_dl_field_t;
+
+/*******************************************************************/
+typedef struct {
+    RADIO_node_action_t node_action;
+    uint16_t sequence;
+} RADIO_action_t;
+
+/*******************************************************************/
+typedef enum {
+    RADIO_ALARM_CONDITION_ABOVE = 0,
+    RADIO_ALARM_CONDITION_BELOW,
+    RADIO_ALARM_CONDITION_LAST
+} RADIO_alarm_condition_t;
+
+/*******************************************************************/
+typedef struct {
+    uint8_t board_id;
+    uint8_t reg_addr;
+    uint32_t field_mask;
+    uint32_t error_value;
+    UNA_get_physical_data_t get_physical_data_pfn;
+    RADIO_alarm_condition_t condition;
+    int32_t threshold;
+    int32_t hysteresis;
+} RADIO_alarm_rule_t;
+
+/*******************************************************************/
+typedef enum {
+    RADIO_ALARM_STATE_UNKNOWN = 0,
+    RADIO_ALARM_STATE_NORMAL,
+    RADIO_ALARM_STATE_ACTIVE,
+    RADIO_ALARM_STATE_LAST
+} RADIO_alarm_state_t;
+
+/*******************************************************************/
+typedef struct {
+    RADIO_alarm_state_t state;
+    uint32_t time_seconds;
+} RADIO_alarm_t;
 
 /*******************************************************************/
 typedef struct {
     // Uplink.
     RADIO_node_t node_list[NODE_LIST_SIZE];
     uint32_t ul_next_time_seconds;
-    uint8_t ul_node_list_index;
+    uint32_t ul_period_seconds;
+    uint32_t ul_mpmcm_next_time_seconds;
+    uint8_t ul_store_flag;
+    uint8_t ul_pending_record[RADIO_UL_PACKED_RECORD_HEADER_SIZE_BYTES + RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES];
+    uint8_t ul_pending_record_size;
+    UNA_node_address_t ul_pending_record_node_addr;
+    RADIO_QUEUE_priority_t ul_pending_record_priority;
     // Downlink.
-    RADIO_dl_payload_t dl_payload;
+    uint8_t dl_payload[UHFM_DL_PAYLOAD_SIZE_BYTES];
+    uint32_t dl_bidirectional_mc;
     uint32_t dl_next_time_seconds;
-    // Node actions list.
-    RADIO_node_action_t action[RADIO_ACTION_LIST_SIZE];
+    // Node actions list (binary min-heap ordered by timestamp, then by recording order).
+    RADIO_action_t action[RADIO_ACTION_LIST_SIZE];
+    uint8_t action_count;
+    uint16_t action_sequence;
+    // Messages budget (tokens are expressed in messages multiplied by the window duration).
+    uint32_t ul_budget_messages;
+    uint32_t dl_budget_messages;
+    uint32_t ul_budget_tokens;
+    uint32_t dl_budget_tokens;
+    uint32_t budget_time_seconds;
+    uint16_t ul_budget_history[RADIO_BUDGET_HISTORY_SIZE];
+    uint8_t dl_budget_history[RADIO_BUDGET_HISTORY_SIZE];
+    uint32_t budget_history_slot;
+    uint8_t ul_cycle_message_count;
+    uint32_t ul_effective_period_seconds;
+    // Threshold alarms.
+    RADIO_alarm_t alarm[RADIO_ALARM_RULE_COUNT_MAX];
     // Specific nodes pointers.
+    uint32_t node_list_generation;
     UNA_node_t* master_node_ptr;
     UNA_node_t* modem_node_ptr;
     UNA_node_t* mpmcm_node_ptr;
@@ -181,10 +227,140 @@ static const RADIO_build_ul_node_payload_t RADIO_NODE_DESCRIPTOR[UNA_BOARD_ID_LA
     &RADIO_BCM_build_ul_node_payload
 };
 
+static const RADIO_CODEC_field_t RADIO_UL_HEADER_FIELDS[] = {
+    { RADIO_UL_HEADER_FIELD_NODE_ADDR, 0, 8 },
+    { RADIO_UL_HEADER_FIELD_BOARD_ID, 8, 8 }
+};
+
+static const RADIO_CODEC_field_t RADIO_UL_RECORD_FIELDS[] = {
+    { RADIO_UL_RECORD_FIELD_NODE_ADDR, 0, 8 },
+    { RADIO_UL_RECORD_FIELD_BOARD_ID, 8, 4 },
+    { RADIO_UL_RECORD_FIELD_NODE_PAYLOAD_SIZE, 12, 4 }
+};
+
+static const RADIO_CODEC_schema_t RADIO_UL_HEADER_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_UL_HEADER_FIELDS, RADIO_UL_PAYLOAD_HEADER_SIZE_BYTES);
+static const RADIO_CODEC_schema_t RADIO_UL_RECORD_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_UL_RECORD_FIELDS, RADIO_UL_PACKED_RECORD_HEADER_SIZE_BYTES);
+
+static const RADIO_CODEC_field_t RADIO_DL_NOP_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 }
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_SINGLE_FULL_READ_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 }
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_FULL_WRITE_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 },
+    { RADIO_DL_FIELD_REG_VALUE, 24, 32 },
+    { RADIO_DL_FIELD_DURATION, 56, 8 } // Unused in single.
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_MASKED_WRITE_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 },
+    { RADIO_DL_FIELD_REG_MASK, 24, 16 },
+    { RADIO_DL_FIELD_REG_VALUE, 40, 16 },
+    { RADIO_DL_FIELD_DURATION, 56, 8 } // Unused in single.
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_SUCCESSIVE_FULL_WRITE_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 },
+    { RADIO_DL_FIELD_REG_VALUE, 24, 16 },
+    { RADIO_DL_FIELD_REG_2_VALUE, 40, 16 },
+    { RADIO_DL_FIELD_DURATION, 56, 8 }
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_SUCCESSIVE_MASKED_WRITE_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 },
+    { RADIO_DL_FIELD_REG_MASK, 24, 8 },
+    { RADIO_DL_FIELD_REG_VALUE, 32, 8 },
+    { RADIO_DL_FIELD_REG_2_VALUE, 40, 8 },
+    { RADIO_DL_FIELD_DURATION, 48, 8 }
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_DUAL_FULL_WRITE_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 },
+    { RADIO_DL_FIELD_REG_VALUE, 24, 16 },
+    { RADIO_DL_FIELD_REG_2_ADDR, 40, 8 },
+    { RADIO_DL_FIELD_REG_2_VALUE, 48, 16 }
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_TRIPLE_FULL_WRITE_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 },
+    { RADIO_DL_FIELD_REG_VALUE, 24, 8 },
+    { RADIO_DL_FIELD_REG_2_ADDR, 32, 8 },
+    { RADIO_DL_FIELD_REG_2_VALUE, 40, 8 },
+    { RADIO_DL_FIELD_REG_3_ADDR, 48, 8 },
+    { RADIO_DL_FIELD_REG_3_VALUE, 56, 8 }
+};
+
+static const RADIO_CODEC_field_t RADIO_DL_DUAL_NODE_WRITE_FIELDS[] = {
+    { RADIO_DL_FIELD_OP_CODE, 0, 8 },
+    { RADIO_DL_FIELD_NODE_ADDR, 8, 8 },
+    { RADIO_DL_FIELD_REG_ADDR, 16, 8 },
+    { RADIO_DL_FIELD_REG_VALUE, 24, 8 },
+    { RADIO_DL_FIELD_NODE_2_ADDR, 32, 8 },
+    { RADIO_DL_FIELD_REG_2_ADDR, 40, 8 },
+    { RADIO_DL_FIELD_REG_2_VALUE, 48, 8 }
+};
+
+static const RADIO_CODEC_schema_t RADIO_DL_SCHEMA[RADIO_DL_OP_CODE_LAST] = {
+    RADIO_CODEC_SCHEMA(RADIO_DL_NOP_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_SINGLE_FULL_READ_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_FULL_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_MASKED_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_FULL_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_MASKED_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_SUCCESSIVE_FULL_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_SUCCESSIVE_MASKED_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_DUAL_FULL_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_TRIPLE_FULL_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES),
+    RADIO_CODEC_SCHEMA(RADIO_DL_DUAL_NODE_WRITE_FIELDS, UHFM_DL_PAYLOAD_SIZE_BYTES)
+};
+
+static const uint8_t RADIO_DL_ACTION_COUNT[RADIO_DL_OP_CODE_LAST] = { 0, 1, 1, 1, 2, 2, 2, 2, 2, 3, 2 };
+
+// Cheap register polls evaluated on each wake-up (hysteresis is applied to leave the alarm state).
+static const RADIO_alarm_rule_t RADIO_ALARM_RULE[] = {
+    { UNA_BOARD_ID_BPSM, BPSM_REGISTER_ADDRESS_STATUS_1, BPSM_REGISTER_STATUS_1_MASK_CVF, UNA_REGISTER_MASK_ALL, NULL, RADIO_ALARM_CONDITION_ABOVE, 0, 0 },
+    { UNA_BOARD_ID_BPSM, BPSM_REGISTER_ADDRESS_ANALOG_DATA_1, BPSM_REGISTER_ANALOG_DATA_1_MASK_STORAGE_VOLTAGE, UNA_VOLTAGE_ERROR_VALUE, &UNA_get_mv, RADIO_ALARM_CONDITION_BELOW, RADIO_ALARM_STORAGE_VOLTAGE_THRESHOLD_MV, RADIO_ALARM_STORAGE_VOLTAGE_HYSTERESIS_MV },
+    { UNA_BOARD_ID_BCM, BCM_REGISTER_ADDRESS_STATUS_1, BCM_REGISTER_STATUS_1_MASK_CVF, UNA_REGISTER_MASK_ALL, NULL, RADIO_ALARM_CONDITION_ABOVE, 0, 0 },
+    { UNA_BOARD_ID_BCM, BCM_REGISTER_ADDRESS_ANALOG_DATA_1, BCM_REGISTER_ANALOG_DATA_1_MASK_STORAGE_VOLTAGE, UNA_VOLTAGE_ERROR_VALUE, &UNA_get_mv, RADIO_ALARM_CONDITION_BELOW, RADIO_ALARM_STORAGE_VOLTAGE_THRESHOLD_MV, RADIO_ALARM_STORAGE_VOLTAGE_HYSTERESIS_MV },
+    { UNA_BOARD_ID_MPMCM, MPMCM_REGISTER_ADDRESS_STATUS_1, MPMCM_REGISTER_STATUS_1_MASK_MVD, UNA_REGISTER_MASK_ALL, NULL, RADIO_ALARM_CONDITION_BELOW, 1, 0 }
+};
+
 static RADIO_context_t radio_ctx = {
     .ul_next_time_seconds = 0,
-    .ul_node_list_index = 0,
+    .ul_period_seconds = 0,
+    .ul_mpmcm_next_time_seconds = 0,
+    .ul_store_flag = 0,
+    .ul_pending_record_size = 0,
+    .ul_pending_record_node_addr = UNA_NODE_ADDRESS_ERROR,
+    .ul_pending_record_priority = RADIO_QUEUE_PRIORITY_ROUTINE,
+    .dl_bidirectional_mc = 0,
     .dl_next_time_seconds = 0,
+    .ul_budget_messages = UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT,
+    .dl_budget_messages = UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT,
+    .ul_budget_tokens = (UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT * RADIO_BUDGET_WINDOW_SECONDS),
+    .dl_budget_tokens = (UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT * RADIO_BUDGET_WINDOW_SECONDS),
+    .budget_time_seconds = 0,
+    .budget_history_slot = 0,
+    .ul_cycle_message_count = 0,
+    .ul_effective_period_seconds = 0,
+    .node_list_generation = 0,
     .master_node_ptr = NULL,
     .modem_node_ptr = NULL,
     .mpmcm_node_ptr = NULL,
@@ -195,112 +371,432 @@ static RADIO_context_t radio_ctx = {
 
 /*** RADIO local functions ***/
 
+/*******************************************************************/
+static RADIO_status_t _RADIO_check_schemas(void) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t idx = 0;
+    // Uplink frames.
+    status = RADIO_CODEC_check_schema(&RADIO_UL_HEADER_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
+    status = RADIO_CODEC_check_schema(&RADIO_UL_RECORD_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
+    // Downlink frames.
+    for (idx = 0; idx < RADIO_DL_OP_CODE_LAST; idx++) {
+        status = RADIO_CODEC_check_schema(&(RADIO_DL_SCHEMA[idx]));
+        if (status != RADIO_SUCCESS) goto errors;
+    }
+    // Node payloads.
+    status = RADIO_COMMON_check_schemas();
+    if (status != RADIO_SUCCESS) goto errors;
+    status = RADIO_BPSM_check_schemas();
+    if (status != RADIO_SUCCESS) goto errors;
+    status = RADIO_UHFM_check_schemas();
+    if (status != RADIO_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
 /*******************************************************************/
 static void _RADIO_reset_node_list(RADIO_node_t* node_list) {
     // Local variables.
+    uint8_t slot_idx = 0;
     uint8_t idx = 0;
     // Reset nodes list.
     for (idx = 0; idx < NODE_LIST_SIZE; idx++) {
         node_list[idx].node = NULL;
+        node_list[idx].node_addr = UNA_NODE_ADDRESS_ERROR;
         node_list[idx].payload_type_counter = RADIO_UL_PAYLOAD_TYPE_COUNTER_ERROR_VALUE;
         node_list[idx].error_stack_payload_counter = 0;
+        node_list[idx].ul_deadline_seconds = 0;
+        node_list[idx].ul_event_pending = 0;
+        node_list[idx].ul_period_seconds = 0;
+        node_list[idx].ul_next_time_seconds = 0;
+        node_list[idx].ul_pattern = 0;
+        node_list[idx].ul_pattern_size = 0;
+        for (slot_idx = 0; slot_idx < RADIO_UL_DEADBAND_SLOT_COUNT; slot_idx++) {
+            node_list[idx].ul_deadband[slot_idx].payload_type = RADIO_UL_DEADBAND_PAYLOAD_TYPE_NONE;
+            node_list[idx].ul_deadband[slot_idx].time_seconds = 0;
+        }
+        node_list[idx].ul_reference.payload_type = RADIO_UL_REFERENCE_PAYLOAD_TYPE_NONE;
+        node_list[idx].ul_reference.delta_count = 0;
+        node_list[idx].ul_reference.transmitted_flag = 0;
+    }
+}
+
+/*******************************************************************/
+static UNA_node_t* _RADIO_get_board_node(uint8_t board_id) {
+    // Local variables.
+    UNA_node_t* node_ptr = NULL;
+    uint8_t list_idx = 0;
+    // Get first node of the given board ID.
+    if (NODE_get_board_list_index(board_id, &list_idx) == NODE_SUCCESS) {
+        node_ptr = &(NODE_LIST.list[list_idx]);
     }
+    return node_ptr;
+}
+
+/*******************************************************************/
+static void _RADIO_update_node_configuration(void) {
+    // Local variables.
+    NODE_status_t node_status = NODE_SUCCESS;
+    UNA_access_status_t read_status;
+    uint32_t dmm_registers[UNA_DMM_REGISTER_ADDRESS_LAST];
+    uint8_t reg_addr_list[(UNA_DMM_RADIO_NODE_SLOT_COUNT << 1) + 4];
+    uint8_t reg_addr = 0;
+    uint32_t reg_configuration = 0;
+    uint32_t pattern_size = 0;
+    uint8_t list_idx = 0;
+    uint8_t idx = 0;
+    // Reset nodes configuration.
+    for (idx = 0; idx < NODE_LIST_SIZE; idx++) {
+        radio_ctx.node_list[idx].ul_period_seconds = 0;
+        radio_ctx.node_list[idx].ul_pattern = 0;
+        radio_ctx.node_list[idx].ul_pattern_size = 0;
+    }
+    // Read all slots and deadbands.
+    for (idx = 0; idx < (UNA_DMM_RADIO_NODE_SLOT_COUNT << 1); idx++) {
+        reg_addr_list[idx] = (UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_0_CONFIGURATION + idx);
+    }
+    reg_addr_list[idx++] = UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_0;
+    reg_addr_list[idx++] = UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_1;
+    reg_addr_list[idx++] = UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_2;
+    reg_addr_list[idx++] = UNA_DMM_REGISTER_ADDRESS_RADIO_AGGREGATION_CONFIGURATION;
+    node_status = NODE_read_registers(radio_ctx.master_node_ptr, (uint8_t*) reg_addr_list, idx, (uint32_t*) dmm_registers, NULL, &read_status);
+    NODE_stack_error(ERROR_BASE_RADIO + RADIO_ERROR_BASE_NODE);
+    if ((node_status != NODE_SUCCESS) || (read_status.flags != 0)) goto errors;
+    RADIO_COMMON_set_deadband_configuration(dmm_registers[UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_0], dmm_registers[UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_1], dmm_registers[UNA_DMM_REGISTER_ADDRESS_RADIO_DEADBAND_2]);
+    RADIO_AGGREGATION_set_sampling_period(UNA_get_seconds(SWREG_read_field(dmm_registers[UNA_DMM_REGISTER_ADDRESS_RADIO_AGGREGATION_CONFIGURATION], UNA_DMM_REGISTER_RADIO_AGGREGATION_CONFIGURATION_MASK_SAMPLING_PERIOD)));
+    // Slots loop.
+    for (idx = 0; idx < UNA_DMM_RADIO_NODE_SLOT_COUNT; idx++) {
+        reg_addr = (UNA_DMM_REGISTER_ADDRESS_RADIO_NODE_0_CONFIGURATION + (idx << 1));
+        reg_configuration = dmm_registers[reg_addr];
+        // Search node.
+        if (NODE_get_list_index((UNA_node_address_t) SWREG_read_field(reg_configuration, UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_NODE_ADDR), &list_idx) != NODE_SUCCESS) continue;
+        // Uplink period (zero means global period).
+        if (SWREG_read_field(reg_configuration, UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_UL_PERIOD) != 0) {
+            radio_ctx.node_list[list_idx].ul_period_seconds = UNA_get_seconds(SWREG_read_field(reg_configuration, UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_UL_PERIOD));
+            if (radio_ctx.node_list[list_idx].ul_period_seconds < RADIO_UL_NODE_PERIOD_SECONDS_MIN) {
+                radio_ctx.node_list[list_idx].ul_period_seconds = RADIO_UL_NODE_PERIOD_SECONDS_MIN;
+            }
+        }
+        // Payload types pattern (zero size means default pattern).
+        pattern_size = SWREG_read_field(reg_configuration, UNA_DMM_REGISTER_RADIO_NODE_CONFIGURATION_MASK_PATTERN_SIZE);
+        if ((pattern_size != 0) && (pattern_size <= UNA_DMM_RADIO_NODE_PATTERN_SIZE_MAX)) {
+            radio_ctx.node_list[list_idx].ul_pattern = SWREG_read_field(dmm_registers[reg_addr + 1], UNA_DMM_REGISTER_RADIO_NODE_PATTERN_MASK_PATTERN);
+            radio_ctx.node_list[list_idx].ul_pattern_size = (uint8_t) pattern_size;
+        }
+    }
+errors:
+    return;
 }
 
 /*******************************************************************/
 static void _RADIO_synchronize_node_list(void) {
     // Local variables.
     RADIO_node_t tmp_node_list[NODE_LIST_SIZE];
-    uint8_t new_idx = 0;
-    uint8_t old_idx = 0;
-    // Reset modem node pointer.
-    radio_ctx.master_node_ptr = NULL;
-    radio_ctx.modem_node_ptr = NULL;
-    radio_ctx.mpmcm_node_ptr = NULL;
-    radio_ctx.power_node_ptr = NULL;
+    uint32_t node_list_generation = NODE_get_list_generation();
+    uint8_t list_idx = 0;
+    uint8_t slot_idx = 0;
+    uint8_t idx = 0;
+    // Directly exit if the node list has not changed.
+    if (node_list_generation == radio_ctx.node_list_generation) goto errors;
     // Reset temporary list.
     _RADIO_reset_node_list((RADIO_node_t*) tmp_node_list);
     // Copy all nodes from official list.
-    for (new_idx = 0; new_idx < NODE_LIST.count; new_idx++) {
-        // Update pointer.
-        tmp_node_list[new_idx].node = &(NODE_LIST.list[new_idx]);
-        tmp_node_list[new_idx].payload_type_counter = 0;
-        tmp_node_list[new_idx].error_stack_payload_counter = 0;
-        // Restore previous payload type counters based on address.
-        for (old_idx = 0; old_idx < NODE_LIST_SIZE; old_idx++) {
-            // Check pointer.
-            if (radio_ctx.node_list[old_idx].node != NULL) {
-                // Compare address.
-                if (((tmp_node_list[new_idx].node)->address) == ((radio_ctx.node_list[old_idx].node)->address)) {
-                    tmp_node_list[new_idx].payload_type_counter = radio_ctx.node_list[old_idx].payload_type_counter;
-                    tmp_node_list[new_idx].error_stack_payload_counter = radio_ctx.node_list[old_idx].error_stack_payload_counter;
-                }
-            }
-        }
-        // Update specific nodes pointer.
-        if (NODE_LIST.list[new_idx].board_id == UNA_BOARD_ID_DMM) {
-            radio_ctx.master_node_ptr = &(NODE_LIST.list[new_idx]);
-        }
-        if (NODE_LIST.list[new_idx].board_id == UNA_BOARD_ID_UHFM) {
-            radio_ctx.modem_node_ptr = &(NODE_LIST.list[new_idx]);
-        }
-        if (NODE_LIST.list[new_idx].board_id == UNA_BOARD_ID_MPMCM) {
-            radio_ctx.mpmcm_node_ptr = &(NODE_LIST.list[new_idx]);
-        }
-        if (NODE_LIST.list[new_idx].board_id == UNA_BOARD_ID_BPSM) {
-            radio_ctx.power_node_ptr = &(NODE_LIST.list[new_idx]);
-            radio_ctx.power_node_cvf_register = BPSM_REGISTER_ADDRESS_STATUS_1;
-            radio_ctx.power_node_cvf_mask = BPSM_REGISTER_STATUS_1_MASK_CVF;
-        }
-        if ((NODE_LIST.list[new_idx].board_id == UNA_BOARD_ID_BCM) && (radio_ctx.power_node_ptr == NULL)) {
-            radio_ctx.power_node_ptr = &(NODE_LIST.list[new_idx]);
-            radio_ctx.power_node_cvf_register = BCM_REGISTER_ADDRESS_STATUS_1;
-            radio_ctx.power_node_cvf_mask = BCM_REGISTER_STATUS_1_MASK_CVF;
+    for (idx = 0; idx < NODE_LIST.count; idx++) {
+        tmp_node_list[idx].node = &(NODE_LIST.list[idx]);
+        tmp_node_list[idx].node_addr = NODE_LIST.list[idx].address;
+        tmp_node_list[idx].payload_type_counter = 0;
+        tmp_node_list[idx].error_stack_payload_counter = 0;
+        tmp_node_list[idx].ul_deadline_seconds = 0;
+        tmp_node_list[idx].ul_event_pending = 0;
+        tmp_node_list[idx].ul_next_time_seconds = 0;
+    }
+    // Restore previous payload type counters based on address.
+    for (idx = 0; idx < NODE_LIST_SIZE; idx++) {
+        // Check entry.
+        if (radio_ctx.node_list[idx].node == NULL) continue;
+        if (NODE_get_list_index(radio_ctx.node_list[idx].node_addr, &list_idx) != NODE_SUCCESS) continue;
+        tmp_node_list[list_idx].payload_type_counter = radio_ctx.node_list[idx].payload_type_counter;
+        tmp_node_list[list_idx].error_stack_payload_counter = radio_ctx.node_list[idx].error_stack_payload_counter;
+        tmp_node_list[list_idx].ul_deadline_seconds = radio_ctx.node_list[idx].ul_deadline_seconds;
+        tmp_node_list[list_idx].ul_next_time_seconds = radio_ctx.node_list[idx].ul_next_time_seconds;
+        for (slot_idx = 0; slot_idx < RADIO_UL_DEADBAND_SLOT_COUNT; slot_idx++) {
+            tmp_node_list[list_idx].ul_deadband[slot_idx] = radio_ctx.node_list[idx].ul_deadband[slot_idx];
         }
+        tmp_node_list[list_idx].ul_reference = radio_ctx.node_list[idx].ul_reference;
     }
-    // Reset old list.
-    _RADIO_reset_node_list((RADIO_node_t*) radio_ctx.node_list);
     // Update local list.
-    for (new_idx = 0; new_idx < NODE_LIST.count; new_idx++) {
-        radio_ctx.node_list[new_idx].node = tmp_node_list[new_idx].node;
-        radio_ctx.node_list[new_idx].payload_type_counter = tmp_node_list[new_idx].payload_type_counter;
-        radio_ctx.node_list[new_idx].error_stack_payload_counter = tmp_node_list[new_idx].error_stack_payload_counter;
+    for (idx = 0; idx < NODE_LIST_SIZE; idx++) {
+        radio_ctx.node_list[idx].node = tmp_node_list[idx].node;
+        radio_ctx.node_list[idx].node_addr = tmp_node_list[idx].node_addr;
+        radio_ctx.node_list[idx].payload_type_counter = tmp_node_list[idx].payload_type_counter;
+        radio_ctx.node_list[idx].error_stack_payload_counter = tmp_node_list[idx].error_stack_payload_counter;
+        radio_ctx.node_list[idx].ul_deadline_seconds = tmp_node_list[idx].ul_deadline_seconds;
+        radio_ctx.node_list[idx].ul_event_pending = tmp_node_list[idx].ul_event_pending;
+        radio_ctx.node_list[idx].ul_next_time_seconds = tmp_node_list[idx].ul_next_time_seconds;
+        for (slot_idx = 0; slot_idx < RADIO_UL_DEADBAND_SLOT_COUNT; slot_idx++) {
+            radio_ctx.node_list[idx].ul_deadband[slot_idx] = tmp_node_list[idx].ul_deadband[slot_idx];
+        }
+        radio_ctx.node_list[idx].ul_reference = tmp_node_list[idx].ul_reference;
+    }
+    // Update specific nodes pointer.
+    radio_ctx.master_node_ptr = _RADIO_get_board_node(UNA_BOARD_ID_DMM);
+    radio_ctx.modem_node_ptr = _RADIO_get_board_node(UNA_BOARD_ID_UHFM);
+    radio_ctx.mpmcm_node_ptr = _RADIO_get_board_node(UNA_BOARD_ID_MPMCM);
+    radio_ctx.power_node_ptr = _RADIO_get_board_node(UNA_BOARD_ID_BPSM);
+    if (radio_ctx.power_node_ptr != NULL) {
+        radio_ctx.power_node_cvf_register = BPSM_REGISTER_ADDRESS_STATUS_1;
+        radio_ctx.power_node_cvf_mask = BPSM_REGISTER_STATUS_1_MASK_CVF;
+    }
+    else {
+        radio_ctx.power_node_ptr = _RADIO_get_board_node(UNA_BOARD_ID_BCM);
+        radio_ctx.power_node_cvf_register = BCM_REGISTER_ADDRESS_STATUS_1;
+        radio_ctx.power_node_cvf_mask = BCM_REGISTER_STATUS_1_MASK_CVF;
     }
+    // Update generation.
+    radio_ctx.node_list_generation = node_list_generation;
+errors:
+    // Configuration may have been changed by downlink.
+    _RADIO_update_node_configuration();
+    return;
 }
 
 /*******************************************************************/
 static RADIO_status_t _RADIO_search_node(UNA_node_address_t node_addr, UNA_node_t** node_ptr) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
-    uint8_t address_match = 0;
-    uint8_t idx = 0;
+    uint8_t list_idx = 0;
     // Reset pointer.
     (*node_ptr) = NULL;
     // Search board in nodes list.
-    for (idx = 0; idx < NODE_LIST.count; idx++) {
-        // Compare address
-        if (NODE_LIST.list[idx].address == node_addr) {
-            address_match = 1;
-            break;
-        }
-    }
-    // Check flag.
-    if (address_match == 0) {
+    if (NODE_get_list_index(node_addr, &list_idx) != NODE_SUCCESS) {
         status = RADIO_ERROR_ACTION_NODE_ADDRESS;
         goto errors;
     }
     // Update pointer.
-    (*node_ptr) = &NODE_LIST.list[idx];
+    (*node_ptr) = &NODE_LIST.list[list_idx];
 errors:
     return status;
 }
 
 /*******************************************************************/
-static RADIO_status_t _RADIO_transmit(UNA_node_t* node, RADIO_ul_payload_t* node_payload, uint8_t bidirectional_flag) {
+static uint8_t _RADIO_check_budget(uint32_t budget_messages, uint32_t budget_tokens, uint32_t message_count) {
+    // A null budget is disabled.
+    return (((budget_messages == 0) || (budget_tokens >= (message_count * RADIO_BUDGET_WINDOW_SECONDS))) ? 1 : 0);
+}
+
+/*******************************************************************/
+static void _RADIO_update_budget_status(void) {
+    // Local variables.
+    uint32_t ul_message_count = 0;
+    uint32_t dl_message_count = 0;
+    uint8_t idx = 0;
+    // Sum messages over the window.
+    for (idx = 0; idx < RADIO_BUDGET_HISTORY_SIZE; idx++) {
+        ul_message_count += radio_ctx.ul_budget_history[idx];
+        dl_message_count += radio_ctx.dl_budget_history[idx];
+    }
+    // Update status registers.
+    UNA_DMM_set_radio_budget_status(ul_message_count, dl_message_count, radio_ctx.ul_effective_period_seconds);
+}
+
+/*******************************************************************/
+static void _RADIO_reset_budget(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Start with a full bucket.
+    radio_ctx.ul_budget_tokens = (radio_ctx.ul_budget_messages * RADIO_BUDGET_WINDOW_SECONDS);
+    radio_ctx.dl_budget_tokens = (radio_ctx.dl_budget_messages * RADIO_BUDGET_WINDOW_SECONDS);
+    radio_ctx.budget_time_seconds = 0;
+    // Reset history.
+    for (idx = 0; idx < RADIO_BUDGET_HISTORY_SIZE; idx++) {
+        radio_ctx.ul_budget_history[idx] = 0;
+        radio_ctx.dl_budget_history[idx] = 0;
+    }
+    radio_ctx.budget_history_slot = 0;
+    radio_ctx.ul_cycle_message_count = 0;
+    radio_ctx.ul_effective_period_seconds = 0;
+    _RADIO_update_budget_status();
+}
+
+/*******************************************************************/
+static void _RADIO_refill_budget(uint32_t uptime_seconds) {
+    // Local variables.
+    uint32_t elapsed_seconds = 0;
+    uint32_t history_slot = (uptime_seconds / RADIO_BUDGET_HISTORY_SLOT_SECONDS);
+    uint8_t idx = 0;
+    // Compute elapsed time since last refill.
+    if (uptime_seconds > radio_ctx.budget_time_seconds) {
+        elapsed_seconds = (uptime_seconds - radio_ctx.budget_time_seconds);
+    }
+    if (elapsed_seconds > RADIO_BUDGET_WINDOW_SECONDS) {
+        elapsed_seconds = RADIO_BUDGET_WINDOW_SECONDS;
+    }
+    radio_ctx.budget_time_seconds = uptime_seconds;
+    // Refill buckets: each message is regenerated after one window divided by the budget.
+    radio_ctx.ul_budget_tokens += (elapsed_seconds * radio_ctx.ul_budget_messages);
+    if (radio_ctx.ul_budget_tokens > (radio_ctx.ul_budget_messages * RADIO_BUDGET_WINDOW_SECONDS)) {
+        radio_ctx.ul_budget_tokens = (radio_ctx.ul_budget_messages * RADIO_BUDGET_WINDOW_SECONDS);
+    }
+    radio_ctx.dl_budget_tokens += (elapsed_seconds * radio_ctx.dl_budget_messages);
+    if (radio_ctx.dl_budget_tokens > (radio_ctx.dl_budget_messages * RADIO_BUDGET_WINDOW_SECONDS)) {
+        radio_ctx.dl_budget_tokens = (radio_ctx.dl_budget_messages * RADIO_BUDGET_WINDOW_SECONDS);
+    }
+    // Clear history slots which left the window.
+    for (idx = 0; idx < RADIO_BUDGET_HISTORY_SIZE; idx++) {
+        if (radio_ctx.budget_history_slot >= history_slot) break;
+        radio_ctx.budget_history_slot++;
+        radio_ctx.ul_budget_history[radio_ctx.budget_history_slot % RADIO_BUDGET_HISTORY_SIZE] = 0;
+        radio_ctx.dl_budget_history[radio_ctx.budget_history_slot % RADIO_BUDGET_HISTORY_SIZE] = 0;
+    }
+    radio_ctx.budget_history_slot = history_slot;
+}
+
+/*******************************************************************/
+static void _RADIO_update_budget_configuration(uint32_t reg_budget) {
+    // Local variables.
+    uint32_t ul_budget_messages = SWREG_read_field(reg_budget, UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_UL_MESSAGES);
+    uint32_t dl_budget_messages = SWREG_read_field(reg_budget, UNA_DMM_REGISTER_RADIO_BUDGET_CONFIGURATION_MASK_DL_MESSAGES);
+    // Update daily budgets.
+    radio_ctx.ul_budget_messages = (ul_budget_messages == 0) ? UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT : ul_budget_messages;
+    radio_ctx.dl_budget_messages = (dl_budget_messages == 0) ? UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT : dl_budget_messages;
+    // Clamp buckets to new capacities.
+    if (radio_ctx.ul_budget_tokens > (radio_ctx.ul_budget_messages * RADIO_BUDGET_WINDOW_SECONDS)) {
+        radio_ctx.ul_budget_tokens = (radio_ctx.ul_budget_messages * RADIO_BUDGET_WINDOW_SECONDS);
+    }
+    if (radio_ctx.dl_budget_tokens > (radio_ctx.dl_budget_messages * RADIO_BUDGET_WINDOW_SECONDS)) {
+        radio_ctx.dl_budget_tokens = (radio_ctx.dl_budget_messages * RADIO_BUDGET_WINDOW_SECONDS);
+    }
+}
+
+/*******************************************************************/
+static void _RADIO_consume_budget(uint8_t bidirectional_flag) {
+    // Local variables.
+    uint8_t history_idx = (radio_ctx.budget_history_slot % RADIO_BUDGET_HISTORY_SIZE);
+    // Uplink message.
+    radio_ctx.ul_budget_tokens = (radio_ctx.ul_budget_tokens > RADIO_BUDGET_WINDOW_SECONDS) ? (radio_ctx.ul_budget_tokens - RADIO_BUDGET_WINDOW_SECONDS) : 0;
+    if (radio_ctx.ul_budget_history[history_idx] < 0xFFFF) {
+        radio_ctx.ul_budget_history[history_idx]++;
+    }
+    if (radio_ctx.ul_cycle_message_count < 0xFF) {
+        radio_ctx.ul_cycle_message_count++;
+    }
+    // Downlink message.
+    if (bidirectional_flag != 0) {
+        radio_ctx.dl_budget_tokens = (radio_ctx.dl_budget_tokens > RADIO_BUDGET_WINDOW_SECONDS) ? (radio_ctx.dl_budget_tokens - RADIO_BUDGET_WINDOW_SECONDS) : 0;
+        if (radio_ctx.dl_budget_history[history_idx] < 0xFF) {
+            radio_ctx.dl_budget_history[history_idx]++;
+        }
+    }
+    _RADIO_update_budget_status();
+}
+
+/*******************************************************************/
+static uint32_t _RADIO_compute_ul_period(uint32_t ul_period_seconds) {
+    // Local variables.
+    uint32_t effective_period_seconds = ul_period_seconds;
+    uint32_t cycle_messages = (radio_ctx.ul_cycle_message_count == 0) ? 1 : radio_ctx.ul_cycle_message_count;
+    uint32_t cycle_tokens = (cycle_messages * RADIO_BUDGET_WINDOW_SECONDS);
+    uint32_t period_seconds = 0;
+    // Stretch period to the sustainable rate when the bucket is less than half full.
+    if (radio_ctx.ul_budget_tokens < (radio_ctx.ul_budget_messages * (RADIO_BUDGET_WINDOW_SECONDS / 2))) {
+        period_seconds = (cycle_tokens / radio_ctx.ul_budget_messages);
+        if (period_seconds > effective_period_seconds) {
+            effective_period_seconds = period_seconds;
+        }
+    }
+    // Wait for enough tokens to perform the next cycle (unless the budget is disabled).
+    if ((radio_ctx.ul_budget_messages != 0) && (radio_ctx.ul_budget_tokens < cycle_tokens)) {
+        period_seconds = (((cycle_tokens - radio_ctx.ul_budget_tokens) + radio_ctx.ul_budget_messages - 1) / radio_ctx.ul_budget_messages);
+        if (period_seconds > effective_period_seconds) {
+            effective_period_seconds = period_seconds;
+        }
+    }
+    // Never exceed the budget window.
+    if (effective_period_seconds > RADIO_BUDGET_WINDOW_SECONDS) {
+        effective_period_seconds = RADIO_BUDGET_WINDOW_SECONDS;
+    }
+    return effective_period_seconds;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_store_frame(uint8_t* ul_payload, uint8_t ul_payload_size, RADIO_QUEUE_priority_t priority) {
+    // Local variables.
+    RADIO_QUEUE_frame_t queue_frame;
+    // Push frame in queue.
+    queue_frame.ul_payload = ul_payload;
+    queue_frame.ul_payload_size = ul_payload_size;
+    queue_frame.priority = priority;
+    return RADIO_QUEUE_push(&queue_frame);
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_send_ul_message(uint8_t* ul_payload, uint8_t ul_payload_size, uint8_t bidirectional_flag) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
-    RADIO_ul_payload_format_t ul_payload;
     UHFM_ul_message_t uhfm_message;
+    // Check messages budget.
+    if ((_RADIO_check_budget(radio_ctx.ul_budget_messages, radio_ctx.ul_budget_tokens, 1) == 0) || ((bidirectional_flag != 0) && (_RADIO_check_budget(radio_ctx.dl_budget_messages, radio_ctx.dl_budget_tokens, 1) == 0))) {
+        status = RADIO_ERROR_MODEM_UL_BUDGET;
+        goto errors;
+    }
+    // Build Sigfox message structure.
+    uhfm_message.ul_payload = ul_payload;
+    uhfm_message.ul_payload_size = ul_payload_size;
+    uhfm_message.bidirectional_flag = bidirectional_flag;
+    // Send message.
+    status = RADIO_UHFM_send_ul_message(radio_ctx.modem_node_ptr, &uhfm_message);
+    if (status != RADIO_SUCCESS) goto errors;
+    // Update messages budget.
+    _RADIO_consume_budget(bidirectional_flag);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_send_frame(uint8_t* ul_payload, uint8_t ul_payload_size, uint8_t bidirectional_flag, RADIO_QUEUE_priority_t priority, uint8_t* transmitted_flag) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    // Reset flag.
+    (*transmitted_flag) = 0;
+    // Store frame if there is no modem or if power is too low to transmit.
+    if ((radio_ctx.modem_node_ptr == NULL) || (radio_ctx.ul_store_flag != 0)) {
+        status = _RADIO_store_frame(ul_payload, ul_payload_size, priority);
+        goto errors;
+    }
+    // Send frame.
+    status = _RADIO_send_ul_message(ul_payload, ul_payload_size, bidirectional_flag);
+    if (status == RADIO_SUCCESS) {
+        (*transmitted_flag) = 1;
+    }
+    // Store frame until the budget is refilled.
+    if (status == RADIO_ERROR_MODEM_UL_BUDGET) {
+        status = _RADIO_store_frame(ul_payload, ul_payload_size, priority);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_wait_modem(void) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    // Check modem.
+    if (radio_ctx.modem_node_ptr == NULL) goto errors;
+    status = RADIO_UHFM_wait_completion(radio_ctx.modem_node_ptr);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_transmit(UNA_node_t* node, RADIO_ul_payload_t* node_payload, uint8_t bidirectional_flag, RADIO_QUEUE_priority_t priority) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t ul_payload[UHFM_UL_PAYLOAD_MAX_SIZE_BYTES];
+    uint32_t ul_header_field[RADIO_UL_HEADER_FIELD_LAST];
+    uint8_t transmitted_flag = 0;
     uint8_t idx = 0;
     // Check parameters.
     if ((node == NULL) || (node_payload == NULL)) {
@@ -319,33 +815,115 @@ static RADIO_status_t _RADIO_transmit(UNA_node_t* node, RADIO_ul_payload_t* node
         status = RADIO_ERROR_UL_NODE_PAYLOAD_SIZE_OVERFLOW;
         goto errors;
     }
-    // Check UHFM board availability.
-    if (radio_ctx.modem_node_ptr == NULL) {
-        status = RADIO_ERROR_MODEM_NODE_NOT_FOUND;
-        goto errors;
-    }
-    // Reset payload.
-    for (idx = 0; idx < UHFM_UL_PAYLOAD_MAX_SIZE_BYTES; idx++) {
-        ul_payload.frame[idx] = 0x00;
-    }
     // Add board ID and node address.
-    ul_payload.board_id = (node->board_id);
-    ul_payload.node_addr = (node->address);
+    ul_header_field[RADIO_UL_HEADER_FIELD_NODE_ADDR] = (node->address);
+    ul_header_field[RADIO_UL_HEADER_FIELD_BOARD_ID] = (node->board_id);
+    status = RADIO_CODEC_pack(&RADIO_UL_HEADER_SCHEMA, (uint32_t*) ul_header_field, (uint8_t*) ul_payload);
+    if (status != RADIO_SUCCESS) goto errors;
     // Add node payload.
     for (idx = 0; idx < (node_payload->payload_size); idx++) {
-        ul_payload.node_payload[idx] = (node_payload->payload)[idx];
+        ul_payload[RADIO_UL_PAYLOAD_HEADER_SIZE_BYTES + idx] = (node_payload->payload)[idx];
     }
-    // Build Sigfox message structure.
-    uhfm_message.ul_payload = (uint8_t*) ul_payload.frame;
-    uhfm_message.ul_payload_size = (RADIO_UL_PAYLOAD_HEADER_SIZE_BYTES + (node_payload->payload_size));
-    uhfm_message.bidirectional_flag = bidirectional_flag;
     // Send message.
-    status = RADIO_UHFM_send_ul_message(radio_ctx.modem_node_ptr, &uhfm_message);
+    status = _RADIO_send_frame((uint8_t*) ul_payload, (RADIO_UL_PAYLOAD_HEADER_SIZE_BYTES + (node_payload->payload_size)), bidirectional_flag, priority, &transmitted_flag);
     if (status != RADIO_SUCCESS) goto errors;
 errors:
     return status;
 }
 
+/*******************************************************************/
+static RADIO_status_t _RADIO_transmit_mpmcm(UNA_node_t* node, RADIO_ul_payload_t* node_payload, uint8_t bidirectional_flag) {
+    // MPMCM data is routine data.
+    return _RADIO_transmit(node, node_payload, bidirectional_flag, RADIO_QUEUE_PRIORITY_ROUTINE);
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_drain_queue(void) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_QUEUE_frame_t queue_frame;
+    uint8_t idx = 0;
+    // Frames loop.
+    for (idx = 0; idx < RADIO_UL_QUEUE_DRAIN_COUNT_MAX; idx++) {
+        // Keep budget for the next regular uplinks.
+        if (_RADIO_check_budget(radio_ctx.ul_budget_messages, radio_ctx.ul_budget_tokens, (RADIO_UL_QUEUE_BUDGET_RESERVE_MESSAGES + 1)) == 0) break;
+        // Get next frame.
+        status = RADIO_QUEUE_peek(&queue_frame);
+        if ((status != RADIO_SUCCESS) || (queue_frame.ul_payload_size == 0)) break;
+        // Send frame (without storing it again if it is rejected).
+        status = _RADIO_send_ul_message(queue_frame.ul_payload, queue_frame.ul_payload_size, 0);
+        if (status != RADIO_SUCCESS) break;
+        RADIO_QUEUE_pop();
+    }
+    return status;
+}
+
+/*******************************************************************/
+static void _RADIO_check_alarms(uint32_t uptime_seconds) {
+    // Local variables.
+    RADIO_status_t radio_status = RADIO_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    UNA_access_status_t read_status;
+    UNA_node_t* node_ptr = NULL;
+    RADIO_ul_payload_t node_payload;
+    uint8_t node_payload_bytes[RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES];
+    uint32_t reg_value = 0;
+    uint32_t field_value = 0;
+    int32_t value = 0;
+    int32_t threshold = 0;
+    uint8_t violation = 0;
+    uint8_t list_idx = 0;
+    uint8_t idx = 0;
+    // Turn bus interface on (alarms are evaluated even without modem since frames are then stored in the uplink queue).
+    POWER_enable(POWER_REQUESTER_ID_RADIO, POWER_DOMAIN_RS485, LPTIM_DELAY_MODE_STOP);
+    // Rules loop.
+    for (idx = 0; idx < RADIO_ALARM_RULE_COUNT; idx++) {
+        // Get watched node.
+        node_ptr = _RADIO_get_board_node(RADIO_ALARM_RULE[idx].board_id);
+        if (node_ptr == NULL) {
+            radio_ctx.alarm[idx].state = RADIO_ALARM_STATE_UNKNOWN;
+            continue;
+        }
+        // Read watched register.
+        node_status = NODE_read_register(node_ptr, RADIO_ALARM_RULE[idx].reg_addr, &reg_value, &read_status);
+        NODE_stack_error(ERROR_BASE_RADIO + RADIO_ERROR_BASE_NODE);
+        if ((node_status != NODE_SUCCESS) || (read_status.flags != 0)) continue;
+        field_value = SWREG_read_field(reg_value, RADIO_ALARM_RULE[idx].field_mask);
+        if (field_value == RADIO_ALARM_RULE[idx].error_value) continue;
+        value = (RADIO_ALARM_RULE[idx].get_physical_data_pfn != NULL) ? ((int32_t) RADIO_ALARM_RULE[idx].get_physical_data_pfn(field_value)) : ((int32_t) field_value);
+        // Hysteresis is applied to leave the alarm state.
+        threshold = RADIO_ALARM_RULE[idx].threshold;
+        if (radio_ctx.alarm[idx].state == RADIO_ALARM_STATE_ACTIVE) {
+            threshold += (RADIO_ALARM_RULE[idx].condition == RADIO_ALARM_CONDITION_ABOVE) ? (-RADIO_ALARM_RULE[idx].hysteresis) : (RADIO_ALARM_RULE[idx].hysteresis);
+        }
+        violation = (RADIO_ALARM_RULE[idx].condition == RADIO_ALARM_CONDITION_ABOVE) ? ((value > threshold) ? 1 : 0) : ((value < threshold) ? 1 : 0);
+        if (violation == 0) {
+            radio_ctx.alarm[idx].state = RADIO_ALARM_STATE_NORMAL;
+            continue;
+        }
+        // Skip alarms already reported (a condition present at first evaluation is reported as a new one).
+        if (radio_ctx.alarm[idx].state == RADIO_ALARM_STATE_ACTIVE) continue;
+        // Rate limiting (the alarm remains pending until the delay is elapsed).
+        if ((radio_ctx.alarm[idx].time_seconds != 0) && (uptime_seconds < (radio_ctx.alarm[idx].time_seconds + RADIO_ALARM_RATE_LIMIT_SECONDS))) continue;
+        // Send alarm immediately.
+        node_payload.payload = (uint8_t*) node_payload_bytes;
+        node_payload.payload_size = 0;
+        radio_status = RADIO_COMMON_build_ul_node_payload_alarm(idx, RADIO_ALARM_RULE[idx].reg_addr, reg_value, &node_payload);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+        if (radio_status != RADIO_SUCCESS) continue;
+        radio_status = _RADIO_transmit(node_ptr, &node_payload, 0, RADIO_QUEUE_PRIORITY_ALARM);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+        if (radio_status != RADIO_SUCCESS) continue;
+        radio_ctx.alarm[idx].state = RADIO_ALARM_STATE_ACTIVE;
+        radio_ctx.alarm[idx].time_seconds = uptime_seconds;
+        // Schedule the full node payload at the next uplink.
+        if (NODE_get_list_index(node_ptr->address, &list_idx) == NODE_SUCCESS) {
+            radio_ctx.node_list[list_idx].ul_next_time_seconds = 0;
+            radio_ctx.node_list[list_idx].ul_deadline_seconds = 0;
+        }
+    }
+}
+
 /*******************************************************************/
 static RADIO_status_t _RADIO_receive(void) {
     // Local variables.
@@ -354,19 +932,21 @@ static RADIO_status_t _RADIO_receive(void) {
     uint8_t dl_payload[UHFM_DL_PAYLOAD_SIZE_BYTES];
     uint8_t idx = 0;
     // Reset operation code.
-    radio_ctx.dl_payload.op_code = RADIO_DL_OP_CODE_NOP;
+    for (idx = 0; idx < UHFM_DL_PAYLOAD_SIZE_BYTES; idx++) {
+        radio_ctx.dl_payload[idx] = 0;
+    }
     // Check UHFM board availability.
     if (radio_ctx.modem_node_ptr == NULL) {
         status = RADIO_ERROR_MODEM_NODE_NOT_FOUND;
         goto errors;
     }
     // Read downlink payload.
-    status = RADIO_UHFM_get_dl_payload((radio_ctx.modem_node_ptr), &dl_payload_available, (uint8_t*) dl_payload);
+    status = RADIO_UHFM_get_dl_payload((radio_ctx.modem_node_ptr), &dl_payload_available, (uint8_t*) dl_payload, &(radio_ctx.dl_bidirectional_mc));
     if (status != RADIO_SUCCESS) goto errors;
     // Update local buffer if new data is available.
     if (dl_payload_available != 0) {
         for (idx = 0; idx < UHFM_DL_PAYLOAD_SIZE_BYTES; idx++) {
-            radio_ctx.dl_payload.frame[idx] = dl_payload[idx];
+            radio_ctx.dl_payload[idx] = dl_payload[idx];
         }
     }
 errors:
@@ -374,91 +954,345 @@ errors:
 }
 
 /*******************************************************************/
-static RADIO_status_t _RADIO_process_uplink(uint8_t bidirectional_flag, uint8_t* message_sent) {
+static void _RADIO_get_ul_schedule(uint32_t uptime_seconds, uint8_t* node_idx_list, uint8_t* node_count) {
+    // Local variables.
+    uint8_t selected[NODE_LIST_SIZE];
+    uint8_t best_idx = 0;
+    uint8_t rank = 0;
+    uint8_t idx = 0;
+    // Reset selection.
+    for (idx = 0; idx < NODE_LIST_SIZE; idx++) {
+        selected[idx] = 0;
+    }
+    (*node_count) = 0;
+    // Select nodes by priority.
+    for (rank = 0; rank < RADIO_UL_SCHEDULE_SIZE; rank++) {
+        best_idx = NODE_LIST_SIZE;
+        for (idx = 0; idx < NODE_LIST.count; idx++) {
+            // Check entry.
+            if ((selected[idx] != 0) || (radio_ctx.node_list[idx].node == NULL)) continue;
+            // Skip nodes whose reporting interval is not elapsed, unless an event is pending.
+            if ((radio_ctx.node_list[idx].ul_event_pending == 0) && (uptime_seconds < radio_ctx.node_list[idx].ul_next_time_seconds)) continue;
+            if (best_idx >= NODE_LIST_SIZE) {
+                best_idx = idx;
+                continue;
+            }
+            // Event driven payloads first.
+            if (radio_ctx.node_list[idx].ul_event_pending != radio_ctx.node_list[best_idx].ul_event_pending) {
+                if (radio_ctx.node_list[idx].ul_event_pending != 0) {
+                    best_idx = idx;
+                }
+                continue;
+            }
+            // Then most overdue node.
+            if (radio_ctx.node_list[idx].ul_deadline_seconds < radio_ctx.node_list[best_idx].ul_deadline_seconds) {
+                best_idx = idx;
+            }
+        }
+        // Check if there is still a candidate.
+        if (best_idx >= NODE_LIST_SIZE) break;
+        selected[best_idx] = 1;
+        node_idx_list[(*node_count)] = best_idx;
+        (*node_count)++;
+    }
+}
+
+/*******************************************************************/
+static void _RADIO_update_ul_deadline(uint8_t node_idx, uint32_t uptime_seconds) {
+    // Power data has a shorter freshness.
+    if ((radio_ctx.power_node_ptr != NULL) && (radio_ctx.node_list[node_idx].node_addr == (radio_ctx.power_node_ptr->address))) {
+        radio_ctx.node_list[node_idx].ul_deadline_seconds = (uptime_seconds + RADIO_UL_FRESHNESS_POWER_SECONDS);
+    }
+    else {
+        radio_ctx.node_list[node_idx].ul_deadline_seconds = (uptime_seconds + RADIO_UL_FRESHNESS_ROUTINE_SECONDS);
+    }
+    // Next reporting time of the node.
+    radio_ctx.node_list[node_idx].ul_next_time_seconds = (uptime_seconds + (((radio_ctx.node_list[node_idx].ul_period_seconds) != 0) ? (radio_ctx.node_list[node_idx].ul_period_seconds) : radio_ctx.ul_period_seconds));
+}
+
+/*******************************************************************/
+static uint32_t _RADIO_get_ul_wakeup_period(uint32_t ul_period_seconds, uint32_t uptime_seconds) {
+    // Local variables.
+    uint32_t wakeup_period_seconds = ul_period_seconds;
+    uint8_t idx = 0;
+    // Wake-up earlier if a node has a shorter reporting interval.
+    for (idx = 0; idx < NODE_LIST.count; idx++) {
+        // Check entry.
+        if ((radio_ctx.node_list[idx].node == NULL) || (radio_ctx.node_list[idx].ul_period_seconds == 0)) continue;
+        if (radio_ctx.node_list[idx].ul_next_time_seconds <= uptime_seconds) {
+            wakeup_period_seconds = 0;
+            break;
+        }
+        if ((radio_ctx.node_list[idx].ul_next_time_seconds - uptime_seconds) < wakeup_period_seconds) {
+            wakeup_period_seconds = (radio_ctx.node_list[idx].ul_next_time_seconds - uptime_seconds);
+        }
+    }
+    if (wakeup_period_seconds < RADIO_UL_NODE_PERIOD_SECONDS_MIN) {
+        wakeup_period_seconds = RADIO_UL_NODE_PERIOD_SECONDS_MIN;
+    }
+    return wakeup_period_seconds;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_build_ul_node_payload(uint8_t node_idx, RADIO_ul_payload_t* node_payload) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
-    RADIO_ul_payload_t node_payload;
-    uint8_t node_payload_bytes[RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES];
-    uint8_t node_idx = radio_ctx.ul_node_list_index;
     uint8_t idx = 0;
     // Reset payload.
-    for (idx = 0; idx < UHFM_UL_PAYLOAD_MAX_SIZE_BYTES; idx++) {
-        node_payload_bytes[idx] = 0x00;
+    for (idx = 0; idx < RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES; idx++) {
+        (node_payload->payload)[idx] = 0x00;
     }
-    // Reset output flag.
-    (*message_sent) = 0;
-    // Build payload structure.
-    node_payload.payload = (uint8_t*) node_payload_bytes;
-    node_payload.payload_size = 0;
-    // Check function pointer.
+    node_payload->payload_size = 0;
+    // Check node and function pointer.
+    if (radio_ctx.node_list[node_idx].node == NULL) goto errors;
     if (RADIO_NODE_DESCRIPTOR[(radio_ctx.node_list[node_idx].node)->board_id] == NULL) goto errors;
+    // Aggregated summary replaces instant samples, unless an event payload is pending.
+    if (radio_ctx.node_list[node_idx].ul_event_pending == 0) {
+        status = RADIO_AGGREGATION_build_ul_node_payload(&(radio_ctx.node_list[node_idx]), node_payload);
+        if ((status != RADIO_SUCCESS) || ((node_payload->payload_size) > 0)) goto errors;
+    }
     // Execute function of the corresponding board ID.
-    status = RADIO_NODE_DESCRIPTOR[(radio_ctx.node_list[node_idx].node)->board_id](&(radio_ctx.node_list[node_idx]), &node_payload);
+    status = RADIO_NODE_DESCRIPTOR[(radio_ctx.node_list[node_idx].node)->board_id](&(radio_ctx.node_list[node_idx]), node_payload);
     if (status != RADIO_SUCCESS) goto errors;
-    // Exit directly if node has no data to send.
-    if (node_payload.payload_size == 0) goto errors;
-    // Transmit message.
-    status = _RADIO_transmit(radio_ctx.node_list[node_idx].node, &node_payload, bidirectional_flag);
-    if (status != RADIO_SUCCESS) goto errors;
-    // Update output flag.
-    (*message_sent) = 1;
+    // Check size.
+    if ((node_payload->payload_size) > RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES) {
+        status = RADIO_ERROR_UL_NODE_PAYLOAD_SIZE_OVERFLOW;
+        goto errors;
+    }
 errors:
     return status;
 }
 
 /*******************************************************************/
-static RADIO_status_t _RADIO_record_action(RADIO_node_action_t* action) {
+static void _RADIO_add_record(RADIO_ul_packed_frame_t* packed_frame, uint8_t* record, uint8_t record_size) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Append record.
+    for (idx = 0; idx < record_size; idx++) {
+        packed_frame->frame[(packed_frame->size) + idx] = record[idx];
+    }
+    packed_frame->size += record_size;
+    packed_frame->record_count++;
+}
+
+/*******************************************************************/
+static void _RADIO_update_ul_references(uint8_t* node_idx_list, uint8_t node_count, uint8_t transmitted_flag) {
+    // Local variables.
+    RADIO_ul_reference_t* reference = NULL;
+    uint8_t idx = 0;
+    // Nodes loop.
+    for (idx = 0; idx < node_count; idx++) {
+        reference = &(radio_ctx.node_list[node_idx_list[idx]].ul_reference);
+        // Delta payloads can only refer to a reference which reached the modem.
+        if (transmitted_flag != 0) {
+            reference->transmitted_flag = 1;
+        }
+        else if ((reference->transmitted_flag) == 0) {
+            reference->payload_type = RADIO_UL_REFERENCE_PAYLOAD_TYPE_NONE;
+        }
+    }
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_process_uplink(uint8_t bidirectional_flag) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_status_t radio_status = RADIO_SUCCESS;
+    RADIO_ul_packed_frame_t packed_frame;
+    uint32_t record_field[RADIO_UL_RECORD_FIELD_LAST];
+    uint32_t ul_header_field[RADIO_UL_HEADER_FIELD_LAST];
+    RADIO_ul_payload_t node_payload;
+    uint8_t record[RADIO_UL_PACKED_RECORD_HEADER_SIZE_BYTES + RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES];
+    uint8_t record_size = 0;
+    uint8_t node_idx_list[RADIO_UL_SCHEDULE_SIZE];
+    uint8_t node_count = 0;
+    uint8_t node_idx = 0;
+    uint8_t record_node_idx_list[RADIO_UL_SCHEDULE_SIZE + 1];
+    RADIO_QUEUE_priority_t priority = RADIO_QUEUE_PRIORITY_ROUTINE;
+    UNA_node_address_t pending_node_addr = UNA_NODE_ADDRESS_ERROR;
+    uint8_t transmitted_flag = 0;
+    uint8_t event_pending = 0;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    uint8_t byte_idx = 0;
     uint8_t idx = 0;
-    uint8_t slot_found = 0;
+    // Init packed frame.
+    packed_frame.frame[0] = RADIO_UL_PACKED_FRAME_MARKER;
+    packed_frame.size = RADIO_UL_PACKED_FRAME_MARKER_SIZE_BYTES;
+    packed_frame.record_count = 0;
+    // Start with the record which did not fit in the previous frame, unless its node has left the list.
+    if (radio_ctx.ul_pending_record_size != 0) {
+        for (idx = 0; idx < NODE_LIST.count; idx++) {
+            if ((radio_ctx.node_list[idx].node != NULL) && (radio_ctx.node_list[idx].node_addr == radio_ctx.ul_pending_record_node_addr)) {
+                record_node_idx_list[packed_frame.record_count] = idx;
+                _RADIO_add_record(&packed_frame, (uint8_t*) radio_ctx.ul_pending_record, radio_ctx.ul_pending_record_size);
+                pending_node_addr = radio_ctx.ul_pending_record_node_addr;
+                priority = radio_ctx.ul_pending_record_priority;
+                break;
+            }
+        }
+        radio_ctx.ul_pending_record_size = 0;
+    }
+    // Build payload structure.
+    node_payload.payload = &(record[RADIO_UL_PACKED_RECORD_HEADER_SIZE_BYTES]);
+    // Compute nodes order.
+    _RADIO_get_ul_schedule(uptime_seconds, (uint8_t*) node_idx_list, &node_count);
+    // Nodes loop.
+    for (idx = 0; idx < node_count; idx++) {
+        node_idx = node_idx_list[idx];
+        // Node already has a record in this frame.
+        if (radio_ctx.node_list[node_idx].node_addr == pending_node_addr) continue;
+        // Node is served whatever the result.
+        event_pending = radio_ctx.node_list[node_idx].ul_event_pending;
+        _RADIO_update_ul_deadline(node_idx, uptime_seconds);
+        // Build node payload.
+        radio_status = _RADIO_build_ul_node_payload(node_idx, &node_payload);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+        // Skip node if it has no data to send.
+        if ((radio_status != RADIO_SUCCESS) || (node_payload.payload_size == 0)) continue;
+        // Build record header.
+        record_field[RADIO_UL_RECORD_FIELD_NODE_ADDR] = ((radio_ctx.node_list[node_idx].node)->address);
+        record_field[RADIO_UL_RECORD_FIELD_BOARD_ID] = ((radio_ctx.node_list[node_idx].node)->board_id);
+        record_field[RADIO_UL_RECORD_FIELD_NODE_PAYLOAD_SIZE] = node_payload.payload_size;
+        radio_status = RADIO_CODEC_pack(&RADIO_UL_RECORD_SCHEMA, (uint32_t*) record_field, (uint8_t*) record);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+        if (radio_status != RADIO_SUCCESS) continue;
+        record_size = (RADIO_UL_PACKED_RECORD_HEADER_SIZE_BYTES + node_payload.payload_size);
+        // Keep record for next frame if it does not fit anymore.
+        if ((packed_frame.record_count != 0) && (((packed_frame.size) + record_size) > UHFM_UL_PAYLOAD_MAX_SIZE_BYTES)) {
+            for (byte_idx = 0; byte_idx < record_size; byte_idx++) {
+                radio_ctx.ul_pending_record[byte_idx] = record[byte_idx];
+            }
+            radio_ctx.ul_pending_record_size = record_size;
+            radio_ctx.ul_pending_record_node_addr = radio_ctx.node_list[node_idx].node_addr;
+            radio_ctx.ul_pending_record_priority = (event_pending != 0) ? RADIO_QUEUE_PRIORITY_EVENT : RADIO_QUEUE_PRIORITY_ROUTINE;
+            break;
+        }
+        record_node_idx_list[packed_frame.record_count] = node_idx;
+        _RADIO_add_record(&packed_frame, (uint8_t*) record, record_size);
+        if (event_pending != 0) {
+            priority = RADIO_QUEUE_PRIORITY_EVENT;
+        }
+    }
+    // Check number of records.
+    if (packed_frame.record_count == 0) goto errors;
+    if (packed_frame.record_count == 1) {
+        // Use single node format: restore full board ID byte in place of the record header.
+        status = RADIO_CODEC_unpack(&RADIO_UL_RECORD_SCHEMA, &(packed_frame.frame[RADIO_UL_PACKED_FRAME_MARKER_SIZE_BYTES]), (uint32_t*) record_field);
+        if (status != RADIO_SUCCESS) goto errors;
+        ul_header_field[RADIO_UL_HEADER_FIELD_NODE_ADDR] = record_field[RADIO_UL_RECORD_FIELD_NODE_ADDR];
+        ul_header_field[RADIO_UL_HEADER_FIELD_BOARD_ID] = record_field[RADIO_UL_RECORD_FIELD_BOARD_ID];
+        status = RADIO_CODEC_pack(&RADIO_UL_HEADER_SCHEMA, (uint32_t*) ul_header_field, &(packed_frame.frame[RADIO_UL_PACKED_FRAME_MARKER_SIZE_BYTES]));
+        if (status != RADIO_SUCCESS) goto errors;
+        status = _RADIO_send_frame(&(packed_frame.frame[RADIO_UL_PACKED_FRAME_MARKER_SIZE_BYTES]), ((packed_frame.size) - RADIO_UL_PACKED_FRAME_MARKER_SIZE_BYTES), bidirectional_flag, priority, &transmitted_flag);
+        if (status != RADIO_SUCCESS) goto errors;
+    }
+    else {
+        // Send packed frame.
+        status = _RADIO_send_frame((uint8_t*) packed_frame.frame, packed_frame.size, bidirectional_flag, priority, &transmitted_flag);
+        if (status != RADIO_SUCCESS) goto errors;
+    }
+errors:
+    _RADIO_update_ul_references((uint8_t*) record_node_idx_list, packed_frame.record_count, transmitted_flag);
+    return status;
+}
+
+/*******************************************************************/
+static uint8_t _RADIO_action_is_before(uint8_t action_index_1, uint8_t action_index_2) {
+    // Local variables.
+    RADIO_action_t* action_1 = &(radio_ctx.action[action_index_1]);
+    RADIO_action_t* action_2 = &(radio_ctx.action[action_index_2]);
+    // Actions with the same timestamp are executed in recording order.
+    if ((action_1->node_action.timestamp_seconds) != (action_2->node_action.timestamp_seconds)) {
+        return (((action_1->node_action.timestamp_seconds) < (action_2->node_action.timestamp_seconds)) ? 1 : 0);
+    }
+    return ((((int16_t) ((action_1->sequence) - (action_2->sequence))) < 0) ? 1 : 0);
+}
+
+/*******************************************************************/
+static void _RADIO_swap_actions(uint8_t action_index_1, uint8_t action_index_2) {
+    // Local variables.
+    RADIO_action_t action_tmp = radio_ctx.action[action_index_1];
+    // Swap entries.
+    radio_ctx.action[action_index_1] = radio_ctx.action[action_index_2];
+    radio_ctx.action[action_index_2] = action_tmp;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_reserve_actions(uint8_t action_count) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    // All actions of a downlink are rejected if one of them can not be recorded.
+    if (action_count > (RADIO_ACTION_LIST_SIZE - radio_ctx.action_count)) {
+        status = RADIO_ERROR_ACTION_LIST_OVERFLOW;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_record_action(RADIO_node_action_t* action) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t action_index = 0;
+    uint8_t parent_index = 0;
     // Check parameter.
     if (action == NULL) {
         status = RADIO_ERROR_NULL_PARAMETER;
         goto errors;
     }
-    // Search available slot.
-    for (idx = 0; idx < RADIO_ACTION_LIST_SIZE; idx++) {
-        // Check node address.
-        if (radio_ctx.action[idx].node == NULL) {
-            // Store action.
-            radio_ctx.action[idx].node = (action->node);
-            radio_ctx.action[idx].downlink_hash = (action->downlink_hash);
-            radio_ctx.action[idx].reg_addr = (action->reg_addr);
-            radio_ctx.action[idx].reg_value = (action->reg_value);
-            radio_ctx.action[idx].reg_mask = (action->reg_mask);
-            radio_ctx.action[idx].timestamp_seconds = (action->timestamp_seconds);
-            radio_ctx.action[idx].access_status = (action->access_status);
-            // Update flag.
-            slot_found = 1;
-            break;
-        }
-    }
-    // Check flag.
-    if (slot_found == 0) {
+    if (radio_ctx.action_count >= RADIO_ACTION_LIST_SIZE) {
         status = RADIO_ERROR_ACTION_LIST_OVERFLOW;
         goto errors;
     }
+    // Store action at the end of the heap.
+    action_index = radio_ctx.action_count;
+    radio_ctx.action[action_index].node_action = (*action);
+    radio_ctx.action[action_index].sequence = radio_ctx.action_sequence;
+    radio_ctx.action_sequence++;
+    radio_ctx.action_count++;
+    // Move action up to its position.
+    while (action_index > 0) {
+        parent_index = ((action_index - 1) >> 1);
+        if (_RADIO_action_is_before(action_index, parent_index) == 0) break;
+        _RADIO_swap_actions(action_index, parent_index);
+        action_index = parent_index;
+    }
 errors:
     return status;
 }
 
 /*******************************************************************/
-static RADIO_status_t _RADIO_remove_action(uint8_t action_index) {
+static RADIO_status_t _RADIO_remove_next_action(RADIO_node_action_t* action) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t action_index = 0;
+    uint8_t child_index = 0;
     // Check parameter.
-    if (action_index >= RADIO_ACTION_LIST_SIZE) {
+    if (action == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (radio_ctx.action_count == 0) {
         status = RADIO_ERROR_ACTION_LIST_INDEX;
         goto errors;
     }
-    radio_ctx.action[action_index].node = NULL;
-    radio_ctx.action[action_index].downlink_hash = RADIO_DL_HASH_ERROR_VALUE;
-    radio_ctx.action[action_index].reg_addr = 0x00;
-    radio_ctx.action[action_index].reg_value = 0;
-    radio_ctx.action[action_index].reg_mask = 0;
-    radio_ctx.action[action_index].timestamp_seconds = 0;
-    radio_ctx.action[action_index].access_status.all = RADIO_DL_ACCESS_STATUS_ERROR_VALUE;
+    // Extract root.
+    (*action) = radio_ctx.action[0].node_action;
+    radio_ctx.action_count--;
+    radio_ctx.action[0] = radio_ctx.action[radio_ctx.action_count];
+    // Move new root down to its position.
+    while (1) {
+        child_index = ((action_index << 1) + 1);
+        if (child_index >= radio_ctx.action_count) break;
+        // Select earliest child.
+        if (((child_index + 1) < radio_ctx.action_count) && (_RADIO_action_is_before((child_index + 1), child_index) != 0)) {
+            child_index++;
+        }
+        if (_RADIO_action_is_before(child_index, action_index) == 0) break;
+        _RADIO_swap_actions(action_index, child_index);
+        action_index = child_index;
+    }
 errors:
     return status;
 }
@@ -470,30 +1304,60 @@ static RADIO_status_t _RADIO_process_downlink(void) {
     NODE_status_t node_status = NODE_SUCCESS;
     UNA_access_status_t access_status;
     RADIO_node_action_t action;
-    uint32_t last_bidirectional_mc = 0;
     UNA_node_t* node_ptr = NULL;
+    UNA_node_t* node_2_ptr = NULL;
     uint32_t previous_reg_value = 0;
+    uint32_t dl_field[RADIO_DL_FIELD_LAST];
+    uint8_t idx = 0;
+    // Reset fields.
+    for (idx = 0; idx < RADIO_DL_FIELD_LAST; idx++) {
+        dl_field[idx] = 0;
+    }
+    // Decode operation code.
+    status = RADIO_CODEC_unpack(&(RADIO_DL_SCHEMA[RADIO_DL_OP_CODE_NOP]), (uint8_t*) radio_ctx.dl_payload, (uint32_t*) dl_field);
+    if (status != RADIO_SUCCESS) goto errors;
     // Directly exit in case of NOP.
-    if (radio_ctx.dl_payload.op_code == RADIO_DL_OP_CODE_NOP) goto errors;
-    // Read last message counter.
-    status = RADIO_UHFM_get_last_bidirectional_mc((radio_ctx.modem_node_ptr), &last_bidirectional_mc);
+    if (dl_field[RADIO_DL_FIELD_OP_CODE] == RADIO_DL_OP_CODE_NOP) goto errors;
+    if (dl_field[RADIO_DL_FIELD_OP_CODE] >= RADIO_DL_OP_CODE_LAST) {
+        status = RADIO_ERROR_DL_OPERATION_CODE;
+        goto errors;
+    }
+    // Decode operation fields.
+    status = RADIO_CODEC_unpack(&(RADIO_DL_SCHEMA[dl_field[RADIO_DL_FIELD_OP_CODE]]), (uint8_t*) radio_ctx.dl_payload, (uint32_t*) dl_field);
+    if (status != RADIO_SUCCESS) goto errors;
+    // Reserve all the actions of the operation.
+    status = _RADIO_reserve_actions(RADIO_DL_ACTION_COUNT[dl_field[RADIO_DL_FIELD_OP_CODE]]);
     if (status != RADIO_SUCCESS) goto errors;
-    // Common action parameters.
-    action.downlink_hash = last_bidirectional_mc;
+    // Resolve all the nodes of the operation before recording any action.
+    status = _RADIO_search_node(dl_field[RADIO_DL_FIELD_NODE_ADDR], &node_ptr);
+    if (status != RADIO_SUCCESS) goto errors;
+    if (dl_field[RADIO_DL_FIELD_OP_CODE] == RADIO_DL_OP_CODE_DUAL_RADIO_WRITE) {
+        status = _RADIO_search_node(dl_field[RADIO_DL_FIELD_NODE_2_ADDR], &node_2_ptr);
+        if (status != RADIO_SUCCESS) goto errors;
+    }
+    // Read the value to restore before recording a temporary write.
+    if ((dl_field[RADIO_DL_FIELD_OP_CODE] == RADIO_DL_OP_CODE_TEMPORARY_FULL_WRITE) || (dl_field[RADIO_DL_FIELD_OP_CODE] == RADIO_DL_OP_CODE_TEMPORARY_MASKED_WRITE)) {
+        node_status = NODE_read_register(node_ptr, dl_field[RADIO_DL_FIELD_REG_ADDR], &previous_reg_value, &access_status);
+        NODE_exit_error(RADIO_ERROR_BASE_NODE);
+        // Check access status.
+        if (access_status.flags != 0) {
+            status = RADIO_ERROR_ACTION_READ_ACCESS;
+            goto errors;
+        }
+    }
+    // Common action parameters (message counter has been read with the payload).
+    action.downlink_hash = radio_ctx.dl_bidirectional_mc;
     action.access_status.all = RADIO_DL_ACCESS_STATUS_ERROR_VALUE;
     // Check operation code.
-    switch (radio_ctx.dl_payload.op_code) {
+    switch (dl_field[RADIO_DL_FIELD_OP_CODE]) {
     case RADIO_DL_OP_CODE_NOP:
         // No operation.
         break;
     case RADIO_DL_OP_CODE_SINGLE_FULL_READ:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.single_full_read.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_READ;
-        action.reg_addr = radio_ctx.dl_payload.single_full_read.reg_addr;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
         action.reg_value = 0;
         action.reg_mask = 0;
         action.timestamp_seconds = 0;
@@ -501,188 +1365,142 @@ static RADIO_status_t _RADIO_process_downlink(void) {
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_SINGLE_FULL_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.full_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.full_write.reg_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.full_write.reg_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
         action.reg_mask = UNA_REGISTER_MASK_ALL;
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_SINGLE_MASKED_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.masked_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.masked_write.reg_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.masked_write.reg_value;
-        action.reg_mask = (uint32_t) radio_ctx.dl_payload.masked_write.reg_mask;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
+        action.reg_mask = (uint32_t) dl_field[RADIO_DL_FIELD_REG_MASK];
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_TEMPORARY_FULL_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.full_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
-        // Read current register value.
-        node_status = NODE_read_register(node_ptr, radio_ctx.dl_payload.full_write.reg_addr, &previous_reg_value, &access_status);
-        NODE_exit_error(RADIO_ERROR_BASE_NODE);
-        // Check access status.
-        if (access_status.flags != 0) {
-            status = RADIO_ERROR_ACTION_READ_ACCESS;
-            goto errors;
-        }
         // Register first action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.full_write.reg_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.full_write.reg_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
         action.reg_mask = UNA_REGISTER_MASK_ALL;
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         // Register second action.
         action.reg_value = previous_reg_value;
-        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(radio_ctx.dl_payload.full_write.duration);
+        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(dl_field[RADIO_DL_FIELD_DURATION]);
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_TEMPORARY_MASKED_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.masked_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
-        // Read current register value.
-        node_status = NODE_read_register(node_ptr, radio_ctx.dl_payload.masked_write.reg_addr, &previous_reg_value, &access_status);
-        NODE_exit_error(RADIO_ERROR_BASE_NODE);
-        // Check access status.
-        if (access_status.flags != 0) {
-            status = RADIO_ERROR_ACTION_READ_ACCESS;
-            goto errors;
-        }
         // Register first action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.masked_write.reg_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.masked_write.reg_value;
-        action.reg_mask = (uint32_t) radio_ctx.dl_payload.masked_write.reg_mask;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
+        action.reg_mask = (uint32_t) dl_field[RADIO_DL_FIELD_REG_MASK];
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         // Register second action.
         action.reg_value = previous_reg_value;
-        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(radio_ctx.dl_payload.masked_write.duration);
+        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(dl_field[RADIO_DL_FIELD_DURATION]);
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_SUCCESSIVE_FULL_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.successive_full_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register first action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.successive_full_write.reg_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.successive_full_write.reg_value_1;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
         action.reg_mask = UNA_REGISTER_MASK_ALL;
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         // Register second action.
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.successive_full_write.reg_value_2;
-        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(radio_ctx.dl_payload.successive_full_write.duration);
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_2_VALUE];
+        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(dl_field[RADIO_DL_FIELD_DURATION]);
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_SUCCESSIVE_MASKED_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.successive_masked_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register first action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.successive_masked_write.reg_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.successive_masked_write.reg_value_1;
-        action.reg_mask = (uint32_t) radio_ctx.dl_payload.successive_masked_write.reg_mask;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
+        action.reg_mask = (uint32_t) dl_field[RADIO_DL_FIELD_REG_MASK];
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         // Register second action.
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.successive_masked_write.reg_value_2;
-        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(radio_ctx.dl_payload.successive_masked_write.duration);
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_2_VALUE];
+        action.timestamp_seconds = RTC_get_uptime_seconds() + UNA_get_seconds(dl_field[RADIO_DL_FIELD_DURATION]);
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_DUAL_FULL_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.dual_full_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register first action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.dual_full_write.reg_1_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.dual_full_write.reg_1_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
         action.reg_mask = UNA_REGISTER_MASK_ALL;
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         // Register second action.
-        action.reg_addr = radio_ctx.dl_payload.dual_full_write.reg_2_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.dual_full_write.reg_2_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_2_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_2_VALUE];
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_TRIPLE_FULL_WRITE:
-        // Search node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.triple_full_write.node_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register first action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.triple_full_write.reg_1_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.triple_full_write.reg_1_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
         action.reg_mask = UNA_REGISTER_MASK_ALL;
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         // Register second action.
-        action.reg_addr = radio_ctx.dl_payload.triple_full_write.reg_2_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.triple_full_write.reg_2_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_2_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_2_VALUE];
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         // Register third action.
-        action.reg_addr = radio_ctx.dl_payload.triple_full_write.reg_3_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.triple_full_write.reg_3_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_3_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_3_VALUE];
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
     case RADIO_DL_OP_CODE_DUAL_RADIO_WRITE:
-        // Search first node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.dual_node_write.node_1_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register first action.
-        action.node = node_ptr;
+        action.node_addr = (node_ptr->address);
         action.access_status.type = UNA_ACCESS_TYPE_WRITE;
-        action.reg_addr = radio_ctx.dl_payload.dual_node_write.reg_1_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.dual_node_write.reg_1_value;
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_VALUE];
         action.reg_mask = UNA_REGISTER_MASK_ALL;
         action.timestamp_seconds = 0;
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
-        // Search second node.
-        status = _RADIO_search_node(radio_ctx.dl_payload.dual_node_write.node_2_addr, &node_ptr);
-        if (status != RADIO_SUCCESS) goto errors;
         // Register second action.
-        action.node = node_ptr;
-        action.reg_addr = radio_ctx.dl_payload.dual_node_write.reg_2_addr;
-        action.reg_value = (uint32_t) radio_ctx.dl_payload.dual_node_write.reg_2_value;
+        action.node_addr = (node_2_ptr->address);
+        action.reg_addr = dl_field[RADIO_DL_FIELD_REG_2_ADDR];
+        action.reg_value = (uint32_t) dl_field[RADIO_DL_FIELD_REG_2_VALUE];
         status = _RADIO_record_action(&action);
         if (status != RADIO_SUCCESS) goto errors;
         break;
@@ -695,52 +1513,85 @@ errors:
 }
 
 /*******************************************************************/
-static RADIO_status_t _RADIO_execute_actions(void) {
+static RADIO_status_t _RADIO_execute_actions(uint32_t time_seconds, uint8_t* bus_enabled_flag) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_status_t radio_status = RADIO_SUCCESS;
     NODE_status_t node_status = NODE_SUCCESS;
     uint8_t node_payload_bytes[RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES];
     RADIO_ul_payload_t node_payload;
     RADIO_node_action_t node_action;
-    uint8_t idx = 0;
-    // Loop on action table.
-    for (idx = 0; idx < RADIO_ACTION_LIST_SIZE; idx++) {
-        // Check NODE pointer and timestamp.
-        if ((radio_ctx.action[idx].node != NULL) && (RTC_get_uptime_seconds() >= radio_ctx.action[idx].timestamp_seconds)) {
-            // Copy action locally.
-            node_action.node = radio_ctx.action[idx].node;
-            node_action.downlink_hash = radio_ctx.action[idx].downlink_hash;
-            node_action.timestamp_seconds = radio_ctx.action[idx].timestamp_seconds;
-            node_action.reg_addr = radio_ctx.action[idx].reg_addr;
-            node_action.reg_mask = radio_ctx.action[idx].reg_mask;
-            node_action.reg_value = radio_ctx.action[idx].reg_value;
-            node_action.access_status = radio_ctx.action[idx].access_status;
-            // Remove action before execution.
-            status = _RADIO_remove_action(idx);
+    UNA_node_t* node_ptr = NULL;
+    UNA_node_t* log_node_ptr = NULL;
+    uint32_t log_downlink_hash = 0;
+    uint8_t session_opened = 0;
+    // Check parameters.
+    if (bus_enabled_flag == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Build payload structure.
+    node_payload.payload = (uint8_t*) node_payload_bytes;
+    node_payload.payload_size = 0;
+    // Open bus session.
+    node_status = NODE_open_session();
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    session_opened = 1;
+    // Execute due actions, earliest first.
+    while ((radio_ctx.action_count > 0) && (radio_ctx.action[0].node_action.timestamp_seconds <= time_seconds)) {
+        // Remove action before execution.
+        status = _RADIO_remove_next_action(&node_action);
+        if (status != RADIO_SUCCESS) goto errors;
+        // Resolve node handle (the node may have disappeared since the downlink).
+        radio_status = _RADIO_search_node(node_action.node_addr, &node_ptr);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+        if (radio_status != RADIO_SUCCESS) continue;
+        // Turn bus interface on.
+        POWER_enable(POWER_REQUESTER_ID_RADIO, POWER_DOMAIN_RS485, LPTIM_DELAY_MODE_STOP);
+        (*bus_enabled_flag) = 1;
+        // Modem registers can not be accessed while transmitting.
+        if (node_ptr == radio_ctx.modem_node_ptr) {
+            radio_status = RADIO_UHFM_wait_completion(node_ptr);
+            RADIO_stack_error(ERROR_BASE_RADIO);
+        }
+        // Perform node access (status is not checked because action log message must be sent whatever the result).
+        if (node_action.access_status.type == UNA_ACCESS_TYPE_WRITE) {
+            node_status = NODE_write_register(node_ptr, node_action.reg_addr, node_action.reg_value, node_action.reg_mask, &(node_action.access_status));
+            NODE_exit_error(RADIO_ERROR_BASE_NODE);
+        }
+        else {
+            node_status = NODE_read_register(node_ptr, node_action.reg_addr, &(node_action.reg_value), &(node_action.access_status));
+            NODE_exit_error(RADIO_ERROR_BASE_NODE);
+        }
+        // Send pending results if the action comes from another downlink or targets another node.
+        if ((node_payload.payload_size != 0) && ((node_ptr != log_node_ptr) || (node_action.downlink_hash != log_downlink_hash))) {
+            status = _RADIO_transmit(log_node_ptr, &node_payload, 0, RADIO_QUEUE_PRIORITY_EVENT);
             if (status != RADIO_SUCCESS) goto errors;
-            // Turn bus interface on.
-            POWER_enable(POWER_REQUESTER_ID_RADIO, POWER_DOMAIN_RS485, LPTIM_DELAY_MODE_STOP);
-            // Perform node access (status is not checked because action log message must be sent whatever the result).
-            if (node_action.access_status.type == UNA_ACCESS_TYPE_WRITE) {
-                node_status = NODE_write_register(node_action.node, node_action.reg_addr, node_action.reg_value, node_action.reg_mask, &(node_action.access_status));
-                NODE_exit_error(RADIO_ERROR_BASE_NODE);
-            }
-            else {
-                node_status = NODE_read_register(node_action.node, node_action.reg_addr, &(node_action.reg_value), &(node_action.access_status));
-                NODE_exit_error(RADIO_ERROR_BASE_NODE);
-            }
-            // Build payload structure.
-            node_payload.payload = (uint8_t*) node_payload_bytes;
             node_payload.payload_size = 0;
-            // Build frame.
-            status = RADIO_COMMON_build_ul_node_payload_action_log(&node_action, &node_payload);
-            if (status != RADIO_SUCCESS) goto errors;
-            // Send action log message.
-            status = _RADIO_transmit(node_action.node, &node_payload, 0);
+        }
+        // Append action result.
+        status = RADIO_COMMON_add_ul_node_payload_action_log(&node_action, &node_payload, RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES);
+        if (status == RADIO_ERROR_UL_NODE_PAYLOAD_SIZE_OVERFLOW) {
+            // Send full frame and start a new one.
+            status = _RADIO_transmit(log_node_ptr, &node_payload, 0, RADIO_QUEUE_PRIORITY_EVENT);
             if (status != RADIO_SUCCESS) goto errors;
+            node_payload.payload_size = 0;
+            status = RADIO_COMMON_add_ul_node_payload_action_log(&node_action, &node_payload, RADIO_UL_NODE_PAYLOAD_MAX_SIZE_BYTES);
         }
+        if (status != RADIO_SUCCESS) goto errors;
+        log_node_ptr = node_ptr;
+        log_downlink_hash = node_action.downlink_hash;
+    }
+    // Send remaining results.
+    if (node_payload.payload_size != 0) {
+        status = _RADIO_transmit(log_node_ptr, &node_payload, 0, RADIO_QUEUE_PRIORITY_EVENT);
+        if (status != RADIO_SUCCESS) goto errors;
     }
 errors:
+    // Close bus session.
+    if (session_opened != 0) {
+        NODE_close_session();
+    }
     return status;
 }
 
@@ -751,15 +1602,36 @@ RADIO_status_t RADIO_init(void) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
     uint8_t idx = 0;
+    // Check frames schemas once for all.
+    status = _RADIO_check_schemas();
+    if (status != RADIO_SUCCESS) goto errors;
     // Init context.
     radio_ctx.ul_next_time_seconds = 0;
-    radio_ctx.ul_node_list_index = 0;
+    radio_ctx.ul_period_seconds = 0;
+    radio_ctx.ul_mpmcm_next_time_seconds = 0;
+    radio_ctx.ul_store_flag = 0;
+    radio_ctx.ul_pending_record_size = 0;
+    radio_ctx.ul_pending_record_node_addr = UNA_NODE_ADDRESS_ERROR;
+    radio_ctx.ul_pending_record_priority = RADIO_QUEUE_PRIORITY_ROUTINE;
+    radio_ctx.dl_bidirectional_mc = 0;
     radio_ctx.dl_next_time_seconds = 0;
     for (idx = 0; idx < UHFM_DL_PAYLOAD_SIZE_BYTES; idx++) {
-        radio_ctx.dl_payload.frame[idx] = 0;
+        radio_ctx.dl_payload[idx] = 0;
+    }
+    // Reset messages budget.
+    radio_ctx.ul_budget_messages = UNA_DMM_SIGFOX_UL_BUDGET_MESSAGES_DEFAULT;
+    radio_ctx.dl_budget_messages = UNA_DMM_SIGFOX_DL_BUDGET_MESSAGES_DEFAULT;
+    _RADIO_reset_budget();
+    // Reset aggregation.
+    RADIO_AGGREGATION_init();
+    // Reset alarms.
+    for (idx = 0; idx < RADIO_ALARM_RULE_COUNT_MAX; idx++) {
+        radio_ctx.alarm[idx].state = RADIO_ALARM_STATE_UNKNOWN;
+        radio_ctx.alarm[idx].time_seconds = 0;
     }
     // Reset nodes list.
     _RADIO_reset_node_list((RADIO_node_t*) radio_ctx.node_list);
+    radio_ctx.node_list_generation = 0;
     radio_ctx.master_node_ptr = NULL;
     radio_ctx.modem_node_ptr = NULL;
     radio_ctx.mpmcm_node_ptr = NULL;
@@ -767,10 +1639,11 @@ RADIO_status_t RADIO_init(void) {
     radio_ctx.power_node_cvf_register = 0xFF;
     radio_ctx.power_node_cvf_mask = UNA_REGISTER_MASK_NONE;
     // Reset actions list.
-    for (idx = 0; idx < RADIO_ACTION_LIST_SIZE; idx++) {
-        status = _RADIO_remove_action(idx);
-        if (status != RADIO_SUCCESS) goto errors;
-    }
+    radio_ctx.action_count = 0;
+    radio_ctx.action_sequence = 0;
+    // Load stored frames.
+    status = RADIO_QUEUE_init();
+    if (status != RADIO_SUCCESS) goto errors;
 errors:
     return status;
 }
@@ -789,27 +1662,45 @@ RADIO_status_t RADIO_process(void) {
     RADIO_status_t radio_status = RADIO_SUCCESS;
     NODE_status_t node_status = NODE_SUCCESS;
     UNA_access_status_t read_status;
-    uint8_t message_sent = 0;
     uint32_t reg_value = 0;
+    uint32_t reg_budget = 0;
     uint8_t bidirectional_flag = 0;
     uint32_t uptime_seconds = RTC_get_uptime_seconds();
     uint8_t ul_next_time_update_required = 0;
     uint8_t dl_next_time_update_required = 0;
-    uint8_t ul_loop = 0;
+    uint8_t queue_flush_required = 0;
+    uint8_t bus_enabled_flag = 0;
+    // Open bus session for the whole radio cycle.
+    node_status = NODE_open_session();
+    NODE_stack_error(ERROR_BASE_RADIO + RADIO_ERROR_BASE_NODE);
+    // Refill messages budget.
+    _RADIO_refill_budget(uptime_seconds);
+    // Evaluate threshold alarms.
+    _RADIO_check_alarms(uptime_seconds);
+    // Sample aggregated nodes data.
+    if (radio_ctx.modem_node_ptr != NULL) {
+        radio_status = RADIO_AGGREGATION_process(uptime_seconds);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+    }
     // Check uplink period.
     if (uptime_seconds >= radio_ctx.ul_next_time_seconds) {
         // Next time update needed.
         ul_next_time_update_required = 1;
-        // Check downlink period.
-        if (uptime_seconds >= radio_ctx.dl_next_time_seconds) {
+        radio_ctx.ul_cycle_message_count = 0;
+        // Check downlink period and budget.
+        if ((uptime_seconds >= radio_ctx.dl_next_time_seconds) && (_RADIO_check_budget(radio_ctx.dl_budget_messages, radio_ctx.dl_budget_tokens, 1) != 0)) {
             // Next time update needed and set bidirectional flag.
             dl_next_time_update_required = 1;
             bidirectional_flag = 1;
         }
         // Synchronize nodes list.
         _RADIO_synchronize_node_list();
-        // Directly exit if there is no modem.
-        if (radio_ctx.modem_node_ptr == NULL) goto errors;
+        // Frames are stored until a modem is available.
+        if (radio_ctx.modem_node_ptr == NULL) {
+            radio_ctx.ul_store_flag = 1;
+            bidirectional_flag = 0;
+            dl_next_time_update_required = 0;
+        }
         // Turn bus interface on.
         POWER_enable(POWER_REQUESTER_ID_RADIO, POWER_DOMAIN_RS485, LPTIM_DELAY_MODE_STOP);
         // Check power node.
@@ -817,29 +1708,21 @@ RADIO_status_t RADIO_process(void) {
             // Read low voltage flag.
             node_status = NODE_read_register(radio_ctx.power_node_ptr, radio_ctx.power_node_cvf_register, &reg_value, &read_status);
             NODE_stack_error(ERROR_BASE_RADIO + RADIO_ERROR_BASE_NODE);
-            // Check status and flag.
-            if ((node_status == NODE_SUCCESS) && (read_status.flags == 0) && (SWREG_read_field(reg_value, radio_ctx.power_node_cvf_mask)) != 0) goto errors;
-        }
-        // Process MPMCM is needed.
-        if (radio_ctx.mpmcm_node_ptr != NULL) {
-            radio_status = RADIO_MPMCM_process(radio_ctx.mpmcm_node_ptr, &_RADIO_transmit);
-            RADIO_stack_error(ERROR_BASE_RADIO);
+            // Store frames instead of transmitting them when voltage is low (and secure them in NVM directly).
+            if ((node_status == NODE_SUCCESS) && (read_status.flags == 0) && (SWREG_read_field(reg_value, radio_ctx.power_node_cvf_mask)) != 0) {
+                radio_ctx.ul_store_flag = 1;
+                queue_flush_required = 1;
+            }
         }
-        do {
-            // Send data through radio.
-            radio_status = _RADIO_process_uplink(bidirectional_flag, &message_sent);
+        // Process MPMCM is needed (at global period since data is accumulated between two calls).
+        if ((radio_ctx.mpmcm_node_ptr != NULL) && (uptime_seconds >= radio_ctx.ul_mpmcm_next_time_seconds)) {
+            radio_ctx.ul_mpmcm_next_time_seconds = (uptime_seconds + radio_ctx.ul_period_seconds);
+            radio_status = RADIO_MPMCM_process(radio_ctx.mpmcm_node_ptr, &_RADIO_transmit_mpmcm);
             RADIO_stack_error(ERROR_BASE_RADIO);
-            // Switch to next node.
-            radio_ctx.ul_node_list_index++;
-            if (radio_ctx.ul_node_list_index >= NODE_LIST.count) {
-                // Come back to first node.
-                radio_ctx.ul_node_list_index = 0;
-            }
-            // Manage loop timeout.
-            ul_loop++;
-            if (ul_loop > RADIO_UL_LOOP_MAX) break;
         }
-        while (message_sent == 0);
+        // Send data through radio.
+        radio_status = _RADIO_process_uplink(bidirectional_flag);
+        RADIO_stack_error(ERROR_BASE_RADIO);
         // Execute downlink operation if needed.
         if (bidirectional_flag != 0) {
             // Read downlink payload.
@@ -850,23 +1733,84 @@ RADIO_status_t RADIO_process(void) {
                 radio_status = _RADIO_process_downlink();
                 RADIO_stack_error(ERROR_BASE_RADIO);
             }
+            // Execute immediate actions before sending stored frames.
+            radio_status = _RADIO_execute_actions(RTC_get_uptime_seconds(), &bus_enabled_flag);
+            RADIO_stack_error(ERROR_BASE_RADIO);
+        }
+        // Send stored frames once modem and power are back.
+        if (radio_ctx.ul_store_flag == 0) {
+            radio_status = _RADIO_drain_queue();
+            RADIO_stack_error(ERROR_BASE_RADIO);
         }
     }
 errors:
-    // Execute actions.
-    radio_status = _RADIO_execute_actions();
+    // Execute due actions.
+    radio_status = _RADIO_execute_actions(RTC_get_uptime_seconds(), &bus_enabled_flag);
     RADIO_stack_error(ERROR_BASE_RADIO);
+    // Write stored frames in NVM.
+    radio_status = RADIO_QUEUE_flush(uptime_seconds, queue_flush_required);
+    RADIO_stack_error(ERROR_BASE_RADIO);
+    radio_ctx.ul_store_flag = 0;
     // Update next radio times.
     node_status = NODE_read_register(radio_ctx.master_node_ptr, DMM_REGISTER_ADDRESS_CONFIGURATION_0, &reg_value, &read_status);
     NODE_stack_error(ERROR_BASE_RADIO + RADIO_ERROR_BASE_NODE);
+    // Update messages budget.
+    node_status = NODE_read_register(radio_ctx.master_node_ptr, UNA_DMM_REGISTER_ADDRESS_RADIO_BUDGET_CONFIGURATION, &reg_budget, &read_status);
+    NODE_stack_error(ERROR_BASE_RADIO + RADIO_ERROR_BASE_NODE);
+    if ((node_status == NODE_SUCCESS) && (read_status.flags == 0)) {
+        _RADIO_update_budget_configuration(reg_budget);
+    }
     // This is done here in case the downlink modified one of the periods (in order to take it into account directly for next radio wake-up).
     if (ul_next_time_update_required != 0) {
-        radio_ctx.ul_next_time_seconds = (uptime_seconds + UNA_get_seconds((uint32_t) SWREG_read_field(reg_value, DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_UL_PERIOD)));
+        radio_ctx.ul_period_seconds = UNA_get_seconds((uint32_t) SWREG_read_field(reg_value, DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_UL_PERIOD));
+        radio_ctx.ul_effective_period_seconds = _RADIO_compute_ul_period(_RADIO_get_ul_wakeup_period(radio_ctx.ul_period_seconds, uptime_seconds));
+        radio_ctx.ul_next_time_seconds = (uptime_seconds + radio_ctx.ul_effective_period_seconds);
+        _RADIO_update_budget_status();
     }
     if (dl_next_time_update_required != 0) {
         radio_ctx.dl_next_time_seconds = (uptime_seconds + UNA_get_seconds((uint32_t) SWREG_read_field(reg_value, DMM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_DL_PERIOD)));
     }
+    // Wait for the last frame before releasing the modem.
+    radio_status = _RADIO_wait_modem();
+    RADIO_stack_error(ERROR_BASE_RADIO);
+    // Close bus session.
+    node_status = NODE_close_session();
+    NODE_stack_error(ERROR_BASE_RADIO + RADIO_ERROR_BASE_NODE);
     // Turn bus interface off.
     POWER_disable(POWER_REQUESTER_ID_RADIO, POWER_DOMAIN_RS485);
     return status;
 }
+
+/*******************************************************************/
+RADIO_status_t RADIO_execute_actions(uint32_t time_seconds) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_status_t radio_status = RADIO_SUCCESS;
+    uint8_t bus_enabled_flag = 0;
+    // Execute actions due at the given time.
+    status = _RADIO_execute_actions(time_seconds, &bus_enabled_flag);
+    // Nothing to release if no action has been performed.
+    if (bus_enabled_flag == 0) goto errors;
+    // Wait for the last action log frame before releasing the modem.
+    radio_status = _RADIO_wait_modem();
+    RADIO_stack_error(ERROR_BASE_RADIO);
+    // Turn bus interface off.
+    POWER_disable(POWER_REQUESTER_ID_RADIO, POWER_DOMAIN_RS485);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_get_next_action_time(uint32_t* next_action_time_seconds) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    // Check parameters.
+    if (next_action_time_seconds == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Earliest action is the heap root.
+    (*next_action_time_seconds) = (radio_ctx.action_count == 0) ? RADIO_ACTION_TIME_NONE : radio_ctx.action[0].node_action.timestamp_seconds;
+errors:
+    return status;
+}
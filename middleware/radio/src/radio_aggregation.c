@@ -0,0 +1,415 @@
+/*
+ * radio_aggregation.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "radio_aggregation.h"
+
+#include "bcm_registers.h"
+#include "bpsm_registers.h"
+#include "ddrm_registers.h"
+#include "error.h"
+#include "lvrm_registers.h"
+#include "node.h"
+#include "power.h"
+#include "radio.h"
+#include "radio_common.h"
+#include "swreg.h"
+#include "types.h"
+#include "una.h"
+
+/*** RADIO AGGREGATION local macros ***/
+
+#define RADIO_AGGREGATION_SLOT_COUNT                4
+#define RADIO_AGGREGATION_DESCRIPTOR_COUNT          (sizeof(RADIO_AGGREGATION_DESCRIPTOR) / sizeof(RADIO_AGGREGATION_descriptor_t))
+
+#define RADIO_AGGREGATION_SAMPLE_COUNT_MAX          0xFFFF
+#define RADIO_AGGREGATION_UL_INTEGRAL_MAX           0x0FFFFFFF
+
+// Integrals are sent with 0.1 mAh and 0.1 mWh resolution.
+#define RADIO_AGGREGATION_CHARGE_UAS_PER_UNIT       360000
+#define RADIO_AGGREGATION_ENERGY_UWS_PER_UNIT       360000
+
+/*** RADIO AGGREGATION local structures ***/
+
+/*******************************************************************/
+typedef enum {
+    RADIO_AGGREGATION_CHANNEL_VOLTAGE = 0,
+    RADIO_AGGREGATION_CHANNEL_CURRENT,
+    RADIO_AGGREGATION_CHANNEL_INTEGRAL,
+    RADIO_AGGREGATION_CHANNEL_LAST
+} RADIO_AGGREGATION_channel_t;
+
+/*******************************************************************/
+typedef struct {
+    uint8_t board_id;
+    uint8_t voltage_reg_addr;
+    uint32_t voltage_mask;
+    uint8_t current_reg_addr;
+    uint32_t current_mask;
+} RADIO_AGGREGATION_descriptor_t;
+
+/*******************************************************************/
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint16_t count;
+} RADIO_AGGREGATION_statistics_t;
+
+/*******************************************************************/
+typedef struct {
+    int64_t charge_uas;
+    int64_t energy_uws;
+    uint32_t duration_seconds;
+} RADIO_AGGREGATION_integral_t;
+
+/*******************************************************************/
+typedef struct {
+    UNA_node_address_t node_addr;
+    uint8_t descriptor_index;
+    uint8_t ul_channel;
+    uint32_t sample_time_seconds;
+    RADIO_AGGREGATION_statistics_t voltage;
+    RADIO_AGGREGATION_statistics_t current;
+    RADIO_AGGREGATION_integral_t integral;
+} RADIO_AGGREGATION_slot_t;
+
+/*******************************************************************/
+typedef union {
+    uint8_t frame[RADIO_COMMON_UL_PAYLOAD_AGGREGATION_SIZE];
+    struct {
+        unsigned marker :4;
+        unsigned channel :4;
+        unsigned sample_count :16;
+        unsigned min :16;
+        unsigned mean :16;
+        unsigned max :16;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} RADIO_AGGREGATION_ul_payload_statistics_t;
+
+/*******************************************************************/
+typedef union {
+    uint8_t frame[RADIO_COMMON_UL_PAYLOAD_AGGREGATION_SIZE];
+    struct {
+        unsigned marker :4;
+        unsigned channel :4;
+        unsigned duration :8;
+        unsigned charge :28;
+        unsigned energy :28;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} RADIO_AGGREGATION_ul_payload_integral_t;
+
+/*******************************************************************/
+typedef struct {
+    uint32_t sampling_period_seconds;
+    uint32_t next_time_seconds;
+    RADIO_AGGREGATION_slot_t slot[RADIO_AGGREGATION_SLOT_COUNT];
+} RADIO_AGGREGATION_context_t;
+
+/*** RADIO AGGREGATION local global variables ***/
+
+static const RADIO_AGGREGATION_descriptor_t RADIO_AGGREGATION_DESCRIPTOR[] = {
+    { UNA_BOARD_ID_LVRM, LVRM_REGISTER_ADDRESS_ANALOG_DATA_1, LVRM_REGISTER_ANALOG_DATA_1_MASK_OUTPUT_VOLTAGE, LVRM_REGISTER_ADDRESS_ANALOG_DATA_2, LVRM_REGISTER_ANALOG_DATA_2_MASK_OUTPUT_CURRENT },
+    { UNA_BOARD_ID_DDRM, DDRM_REGISTER_ADDRESS_ANALOG_DATA_1, DDRM_REGISTER_ANALOG_DATA_1_MASK_OUTPUT_VOLTAGE, DDRM_REGISTER_ADDRESS_ANALOG_DATA_2, DDRM_REGISTER_ANALOG_DATA_2_MASK_OUTPUT_CURRENT },
+    { UNA_BOARD_ID_BPSM, BPSM_REGISTER_ADDRESS_ANALOG_DATA_1, BPSM_REGISTER_ANALOG_DATA_1_MASK_STORAGE_VOLTAGE, 0x00, UNA_REGISTER_MASK_NONE },
+    { UNA_BOARD_ID_BCM, BCM_REGISTER_ADDRESS_ANALOG_DATA_1, BCM_REGISTER_ANALOG_DATA_1_MASK_STORAGE_VOLTAGE, BCM_REGISTER_ADDRESS_ANALOG_DATA_2, BCM_REGISTER_ANALOG_DATA_2_MASK_CHARGE_CURRENT }
+};
+
+static RADIO_AGGREGATION_context_t radio_aggregation_ctx;
+
+/*** RADIO AGGREGATION local functions ***/
+
+/*******************************************************************/
+static void _RADIO_AGGREGATION_reset_statistics(RADIO_AGGREGATION_statistics_t* statistics) {
+    // Reset accumulators.
+    statistics->min = 0;
+    statistics->max = 0;
+    statistics->sum = 0;
+    statistics->count = 0;
+}
+
+/*******************************************************************/
+static void _RADIO_AGGREGATION_reset_integral(RADIO_AGGREGATION_integral_t* integral) {
+    // Reset accumulators.
+    integral->charge_uas = 0;
+    integral->energy_uws = 0;
+    integral->duration_seconds = 0;
+}
+
+/*******************************************************************/
+static void _RADIO_AGGREGATION_reset_slot(uint8_t slot_idx) {
+    // Reset slot.
+    radio_aggregation_ctx.slot[slot_idx].node_addr = UNA_NODE_ADDRESS_ERROR;
+    radio_aggregation_ctx.slot[slot_idx].descriptor_index = 0;
+    radio_aggregation_ctx.slot[slot_idx].ul_channel = 0;
+    radio_aggregation_ctx.slot[slot_idx].sample_time_seconds = 0;
+    _RADIO_AGGREGATION_reset_statistics(&(radio_aggregation_ctx.slot[slot_idx].voltage));
+    _RADIO_AGGREGATION_reset_statistics(&(radio_aggregation_ctx.slot[slot_idx].current));
+    _RADIO_AGGREGATION_reset_integral(&(radio_aggregation_ctx.slot[slot_idx].integral));
+}
+
+/*******************************************************************/
+static uint8_t _RADIO_AGGREGATION_get_slot_index(UNA_node_address_t node_addr) {
+    // Local variables.
+    uint8_t slot_idx = 0;
+    // Search node.
+    for (slot_idx = 0; slot_idx < RADIO_AGGREGATION_SLOT_COUNT; slot_idx++) {
+        if (radio_aggregation_ctx.slot[slot_idx].node_addr == node_addr) break;
+    }
+    return slot_idx;
+}
+
+/*******************************************************************/
+static void _RADIO_AGGREGATION_update_slots(void) {
+    // Local variables.
+    uint8_t descriptor_idx = 0;
+    uint8_t slot_idx = 0;
+    uint8_t list_idx = 0;
+    uint8_t idx = 0;
+    // Release slots of removed nodes.
+    for (slot_idx = 0; slot_idx < RADIO_AGGREGATION_SLOT_COUNT; slot_idx++) {
+        if (radio_aggregation_ctx.slot[slot_idx].node_addr == UNA_NODE_ADDRESS_ERROR) continue;
+        if (NODE_get_list_index(radio_aggregation_ctx.slot[slot_idx].node_addr, &list_idx) != NODE_SUCCESS) {
+            _RADIO_AGGREGATION_reset_slot(slot_idx);
+            continue;
+        }
+        if (NODE_LIST.list[list_idx].board_id != RADIO_AGGREGATION_DESCRIPTOR[radio_aggregation_ctx.slot[slot_idx].descriptor_index].board_id) {
+            _RADIO_AGGREGATION_reset_slot(slot_idx);
+        }
+    }
+    // Allocate slots to new nodes.
+    for (idx = 0; idx < NODE_LIST.count; idx++) {
+        // Check board.
+        for (descriptor_idx = 0; descriptor_idx < RADIO_AGGREGATION_DESCRIPTOR_COUNT; descriptor_idx++) {
+            if (NODE_LIST.list[idx].board_id == RADIO_AGGREGATION_DESCRIPTOR[descriptor_idx].board_id) break;
+        }
+        if (descriptor_idx >= RADIO_AGGREGATION_DESCRIPTOR_COUNT) continue;
+        // Check if node is already aggregated.
+        if (_RADIO_AGGREGATION_get_slot_index(NODE_LIST.list[idx].address) < RADIO_AGGREGATION_SLOT_COUNT) continue;
+        // Search free slot.
+        slot_idx = _RADIO_AGGREGATION_get_slot_index(UNA_NODE_ADDRESS_ERROR);
+        if (slot_idx >= RADIO_AGGREGATION_SLOT_COUNT) break;
+        radio_aggregation_ctx.slot[slot_idx].node_addr = NODE_LIST.list[idx].address;
+        radio_aggregation_ctx.slot[slot_idx].descriptor_index = descriptor_idx;
+    }
+}
+
+/*******************************************************************/
+static void _RADIO_AGGREGATION_add_sample(RADIO_AGGREGATION_statistics_t* statistics, int32_t value) {
+    // Saturate number of samples.
+    if ((statistics->count) >= RADIO_AGGREGATION_SAMPLE_COUNT_MAX) goto errors;
+    // Update extremums.
+    if (((statistics->count) == 0) || (value < (statistics->min))) {
+        statistics->min = value;
+    }
+    if (((statistics->count) == 0) || (value > (statistics->max))) {
+        statistics->max = value;
+    }
+    // Update sum.
+    statistics->sum += (int64_t) value;
+    statistics->count++;
+errors:
+    return;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_AGGREGATION_sample(uint8_t slot_idx, uint32_t uptime_seconds) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    UNA_access_status_t write_status;
+    UNA_access_status_t read_status;
+    RADIO_AGGREGATION_slot_t* slot = &(radio_aggregation_ctx.slot[slot_idx]);
+    const RADIO_AGGREGATION_descriptor_t* descriptor = &(RADIO_AGGREGATION_DESCRIPTOR[slot->descriptor_index]);
+    UNA_node_t* node = NULL;
+    uint32_t reg_value = 0;
+    uint32_t field_value = 0;
+    int32_t voltage_mv = 0;
+    int32_t current_ua = 0;
+    uint32_t delta_seconds = 0;
+    uint8_t list_idx = 0;
+    // Get node.
+    if (NODE_get_list_index(slot->node_addr, &list_idx) != NODE_SUCCESS) goto errors;
+    node = &(NODE_LIST.list[list_idx]);
+    // Perform measurements.
+    node_status = NODE_perform_measurements(node, &write_status);
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    if (write_status.flags != 0) goto errors;
+    // Read voltage.
+    node_status = NODE_read_register(node, descriptor->voltage_reg_addr, &reg_value, &read_status);
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    if (read_status.flags != 0) goto errors;
+    field_value = SWREG_read_field(reg_value, descriptor->voltage_mask);
+    if (field_value == UNA_VOLTAGE_ERROR_VALUE) goto errors;
+    voltage_mv = UNA_get_mv(field_value);
+    _RADIO_AGGREGATION_add_sample(&(slot->voltage), voltage_mv);
+    // Check current channel.
+    if ((descriptor->current_mask) == UNA_REGISTER_MASK_NONE) goto errors;
+    // Read current.
+    node_status = NODE_read_register(node, descriptor->current_reg_addr, &reg_value, &read_status);
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    if (read_status.flags != 0) goto errors;
+    field_value = SWREG_read_field(reg_value, descriptor->current_mask);
+    if (field_value == UNA_CURRENT_ERROR_VALUE) goto errors;
+    current_ua = UNA_get_ua(field_value);
+    _RADIO_AGGREGATION_add_sample(&(slot->current), current_ua);
+    // Integrate charge and energy since previous sample.
+    if ((slot->sample_time_seconds) != 0) {
+        delta_seconds = (uptime_seconds - (slot->sample_time_seconds));
+        slot->integral.charge_uas += ((int64_t) current_ua) * ((int64_t) delta_seconds);
+        slot->integral.energy_uws += ((((int64_t) voltage_mv) * ((int64_t) current_ua)) / 1000) * ((int64_t) delta_seconds);
+        slot->integral.duration_seconds += delta_seconds;
+    }
+    slot->sample_time_seconds = uptime_seconds;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static uint32_t _RADIO_AGGREGATION_convert_integral(int64_t integral, int64_t unit) {
+    // Local variables.
+    int64_t value = (integral / unit);
+    // Saturate to payload field.
+    if (value < 0) {
+        value = 0;
+    }
+    if (value > RADIO_AGGREGATION_UL_INTEGRAL_MAX) {
+        value = RADIO_AGGREGATION_UL_INTEGRAL_MAX;
+    }
+    return ((uint32_t) value);
+}
+
+/*** RADIO AGGREGATION functions ***/
+
+/*******************************************************************/
+void RADIO_AGGREGATION_init(void) {
+    // Local variables.
+    uint8_t slot_idx = 0;
+    // Init context.
+    radio_aggregation_ctx.sampling_period_seconds = 0;
+    radio_aggregation_ctx.next_time_seconds = 0;
+    for (slot_idx = 0; slot_idx < RADIO_AGGREGATION_SLOT_COUNT; slot_idx++) {
+        _RADIO_AGGREGATION_reset_slot(slot_idx);
+    }
+}
+
+/*******************************************************************/
+void RADIO_AGGREGATION_set_sampling_period(uint32_t sampling_period_seconds) {
+    // Local variables.
+    uint8_t slot_idx = 0;
+    // Restart aggregation when disabled.
+    if ((sampling_period_seconds == 0) && (radio_aggregation_ctx.sampling_period_seconds != 0)) {
+        for (slot_idx = 0; slot_idx < RADIO_AGGREGATION_SLOT_COUNT; slot_idx++) {
+            _RADIO_AGGREGATION_reset_slot(slot_idx);
+        }
+    }
+    radio_aggregation_ctx.sampling_period_seconds = sampling_period_seconds;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_AGGREGATION_process(uint32_t uptime_seconds) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_status_t radio_status = RADIO_SUCCESS;
+    uint8_t slot_idx = 0;
+    // Check sampling period.
+    if (radio_aggregation_ctx.sampling_period_seconds == 0) goto errors;
+    if (uptime_seconds < radio_aggregation_ctx.next_time_seconds) goto errors;
+    radio_aggregation_ctx.next_time_seconds = (uptime_seconds + radio_aggregation_ctx.sampling_period_seconds);
+    // Update slots.
+    _RADIO_AGGREGATION_update_slots();
+    // Turn bus interface on.
+    POWER_enable(POWER_REQUESTER_ID_RADIO, POWER_DOMAIN_RS485, LPTIM_DELAY_MODE_STOP);
+    // Slots loop.
+    for (slot_idx = 0; slot_idx < RADIO_AGGREGATION_SLOT_COUNT; slot_idx++) {
+        // Check slot.
+        if (radio_aggregation_ctx.slot[slot_idx].node_addr == UNA_NODE_ADDRESS_ERROR) continue;
+        radio_status = _RADIO_AGGREGATION_sample(slot_idx, uptime_seconds);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_AGGREGATION_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_AGGREGATION_ul_payload_statistics_t ul_payload_statistics;
+    RADIO_AGGREGATION_ul_payload_integral_t ul_payload_integral;
+    RADIO_AGGREGATION_statistics_t* statistics = NULL;
+    RADIO_AGGREGATION_slot_t* slot = NULL;
+    uint8_t* frame = NULL;
+    uint8_t channel = 0;
+    uint8_t slot_idx = 0;
+    uint8_t idx = 0;
+    // Check parameters.
+    if ((radio_node == NULL) || (node_payload == NULL)) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((node_payload->payload) == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    node_payload->payload_size = 0;
+    // Check aggregation.
+    if (radio_aggregation_ctx.sampling_period_seconds == 0) goto errors;
+    slot_idx = _RADIO_AGGREGATION_get_slot_index(radio_node->node_addr);
+    if (slot_idx >= RADIO_AGGREGATION_SLOT_COUNT) goto errors;
+    slot = &(radio_aggregation_ctx.slot[slot_idx]);
+    // Channels are sent in turn, followed by the regular payload of the node.
+    channel = (slot->ul_channel);
+    slot->ul_channel = (((slot->ul_channel) >= RADIO_AGGREGATION_CHANNEL_LAST) ? 0 : ((slot->ul_channel) + 1));
+    if ((RADIO_AGGREGATION_DESCRIPTOR[slot->descriptor_index].current_mask == UNA_REGISTER_MASK_NONE) && (channel != RADIO_AGGREGATION_CHANNEL_VOLTAGE)) {
+        slot->ul_channel = 0;
+        goto errors;
+    }
+    switch (channel) {
+    case RADIO_AGGREGATION_CHANNEL_VOLTAGE:
+    case RADIO_AGGREGATION_CHANNEL_CURRENT:
+        statistics = (channel == RADIO_AGGREGATION_CHANNEL_VOLTAGE) ? &(slot->voltage) : &(slot->current);
+        if ((statistics->count) == 0) goto errors;
+        // Build statistics payload.
+        ul_payload_statistics.marker = RADIO_COMMON_UL_PAYLOAD_AGGREGATION_MARKER;
+        ul_payload_statistics.channel = channel;
+        ul_payload_statistics.sample_count = (statistics->count);
+        if (channel == RADIO_AGGREGATION_CHANNEL_VOLTAGE) {
+            ul_payload_statistics.min = UNA_convert_mv(statistics->min);
+            ul_payload_statistics.mean = UNA_convert_mv((int32_t) ((statistics->sum) / ((int64_t) (statistics->count))));
+            ul_payload_statistics.max = UNA_convert_mv(statistics->max);
+        }
+        else {
+            ul_payload_statistics.min = UNA_convert_ua(statistics->min);
+            ul_payload_statistics.mean = UNA_convert_ua((int32_t) ((statistics->sum) / ((int64_t) (statistics->count))));
+            ul_payload_statistics.max = UNA_convert_ua(statistics->max);
+        }
+        _RADIO_AGGREGATION_reset_statistics(statistics);
+        frame = (uint8_t*) ul_payload_statistics.frame;
+        break;
+    case RADIO_AGGREGATION_CHANNEL_INTEGRAL:
+        if (slot->integral.duration_seconds == 0) goto errors;
+        // Build integral payload.
+        ul_payload_integral.marker = RADIO_COMMON_UL_PAYLOAD_AGGREGATION_MARKER;
+        ul_payload_integral.channel = channel;
+        ul_payload_integral.duration = UNA_convert_seconds(slot->integral.duration_seconds);
+        ul_payload_integral.charge = _RADIO_AGGREGATION_convert_integral(slot->integral.charge_uas, RADIO_AGGREGATION_CHARGE_UAS_PER_UNIT);
+        ul_payload_integral.energy = _RADIO_AGGREGATION_convert_integral(slot->integral.energy_uws, RADIO_AGGREGATION_ENERGY_UWS_PER_UNIT);
+        _RADIO_AGGREGATION_reset_integral(&(slot->integral));
+        frame = (uint8_t*) ul_payload_integral.frame;
+        break;
+    default:
+        // Regular payload.
+        goto errors;
+    }
+    // Copy payload.
+    for (idx = 0; idx < RADIO_COMMON_UL_PAYLOAD_AGGREGATION_SIZE; idx++) {
+        (node_payload->payload)[idx] = frame[idx];
+    }
+    node_payload->payload_size = RADIO_COMMON_UL_PAYLOAD_AGGREGATION_SIZE;
+errors:
+    return status;
+}
@@ -78,6 +78,17 @@ static const RADIO_BCM_ul_payload_type_t RADIO_BCM_UL_PAYLOAD_PATTERN[] = {
     RADIO_BCM_UL_PAYLOAD_TYPE_MONITORING
 };
 
+static const RADIO_COMMON_data_type_t RADIO_BCM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE[] = {
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_CURRENT,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE
+};
+
 /*** RADIO BCM functions ***/
 
 /*******************************************************************/
@@ -89,6 +100,9 @@ RADIO_status_t RADIO_BCM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_u
     uint32_t bcm_registers[BCM_REGISTER_ADDRESS_LAST];
     RADIO_BCM_ul_payload_monitoring_t ul_payload_monitoring;
     RADIO_BCM_ul_payload_electrical_t ul_payload_electrical;
+    uint32_t deadband_field[RADIO_UL_DEADBAND_FIELD_COUNT_MAX];
+    uint8_t send_required = 1;
+    uint8_t payload_type = 0;
     uint8_t idx = 0;
     // Check parameters.
     if ((radio_node == NULL) || (node_payload == NULL)) {
@@ -111,7 +125,9 @@ RADIO_status_t RADIO_BCM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_u
     // Directly exits if a common payload was computed.
     if ((node_payload->payload_size) > 0) goto errors;
     // Else use specific pattern of the node.
-    switch (RADIO_BCM_UL_PAYLOAD_PATTERN[radio_node->payload_type_counter]) {
+    status = RADIO_COMMON_get_ul_payload_type(radio_node, (const uint8_t*) RADIO_BCM_UL_PAYLOAD_PATTERN, sizeof(RADIO_BCM_UL_PAYLOAD_PATTERN), RADIO_BCM_UL_PAYLOAD_TYPE_LAST, &payload_type);
+    if (status != RADIO_SUCCESS) goto errors;
+    switch (payload_type) {
     case RADIO_BCM_UL_PAYLOAD_TYPE_MONITORING:
         // Perform measurements.
         node_status = NODE_perform_measurements((radio_node->node), &access_status);
@@ -119,7 +135,7 @@ RADIO_status_t RADIO_BCM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_u
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BCM_REGISTERS_MONITORING, sizeof(RADIO_BCM_REGISTERS_MONITORING), (uint32_t*) bcm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BCM_REGISTERS_MONITORING, sizeof(RADIO_BCM_REGISTERS_MONITORING), (uint32_t*) bcm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
         // Build monitoring payload.
@@ -138,7 +154,7 @@ RADIO_status_t RADIO_BCM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_u
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BCM_REGISTERS_ELECTRICAL, sizeof(RADIO_BCM_REGISTERS_ELECTRICAL), (uint32_t*) bcm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BCM_REGISTERS_ELECTRICAL, sizeof(RADIO_BCM_REGISTERS_ELECTRICAL), (uint32_t*) bcm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
         // Build data payload.
@@ -150,6 +166,18 @@ RADIO_status_t RADIO_BCM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_u
         ul_payload_electrical.charge_status0 = SWREG_read_field(bcm_registers[BCM_REGISTER_ADDRESS_STATUS_1], BCM_REGISTER_STATUS_1_MASK_CHST0);
         ul_payload_electrical.charge_control_state = SWREG_read_field(bcm_registers[BCM_REGISTER_ADDRESS_STATUS_1], BCM_REGISTER_STATUS_1_MASK_CHCS);
         ul_payload_electrical.backup_control_state = SWREG_read_field(bcm_registers[BCM_REGISTER_ADDRESS_STATUS_1], BCM_REGISTER_STATUS_1_MASK_BKCS);
+        // Skip payload if data did not change significantly.
+        deadband_field[0] = ul_payload_electrical.source_voltage;
+        deadband_field[1] = ul_payload_electrical.storage_voltage;
+        deadband_field[2] = ul_payload_electrical.charge_current;
+        deadband_field[3] = ul_payload_electrical.backup_voltage;
+        deadband_field[4] = ul_payload_electrical.charge_status1;
+        deadband_field[5] = ul_payload_electrical.charge_status0;
+        deadband_field[6] = ul_payload_electrical.charge_control_state;
+        deadband_field[7] = ul_payload_electrical.backup_control_state;
+        status = RADIO_COMMON_check_deadband(radio_node, payload_type, RADIO_BCM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE, (uint32_t*) deadband_field, sizeof(RADIO_BCM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE), &send_required);
+        if (status != RADIO_SUCCESS) goto errors;
+        if (send_required == 0) break;
         // Copy payload.
         for (idx = 0; idx < RADIO_BCM_UL_PAYLOAD_ELECTRICAL_SIZE; idx++) {
             (node_payload->payload)[idx] = ul_payload_electrical.frame[idx];
@@ -161,7 +189,7 @@ RADIO_status_t RADIO_BCM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_u
         goto errors;
     }
     // Increment payload type counter.
-    radio_node->payload_type_counter = (((radio_node->payload_type_counter) + 1) % sizeof(RADIO_BCM_UL_PAYLOAD_PATTERN));
+    RADIO_COMMON_increment_ul_payload_type(radio_node, sizeof(RADIO_BCM_UL_PAYLOAD_PATTERN));
 errors:
     return status;
 }
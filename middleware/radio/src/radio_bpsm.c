@@ -9,7 +9,9 @@
 
 #include "bpsm_registers.h"
 #include "common_registers.h"
+#include "dmm_flags.h"
 #include "radio.h"
+#include "radio_codec.h"
 #include "radio_common.h"
 #include "swreg.h"
 #include "una.h"
@@ -19,6 +21,22 @@
 #define RADIO_BPSM_UL_PAYLOAD_MONITORING_SIZE   4
 #define RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_SIZE   7
 
+#define RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SIZE               6
+#define RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SIZE_NO_BACKUP     5
+#define RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_SIZE                 4
+
+#define RADIO_BPSM_COMPACT_VOLTAGE_LSB_MV                           20
+#define RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS                        11
+#define RADIO_BPSM_COMPACT_VOLTAGE_ERROR_VALUE                      ((0b1 << RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS) - 1)
+#define RADIO_BPSM_COMPACT_DELTA_SIZE_BITS                          6
+#define RADIO_BPSM_COMPACT_DELTA_MIN                                (-(0b1 << (RADIO_BPSM_COMPACT_DELTA_SIZE_BITS - 1)))
+#define RADIO_BPSM_COMPACT_DELTA_MAX                                ((0b1 << (RADIO_BPSM_COMPACT_DELTA_SIZE_BITS - 1)) - 1)
+#define RADIO_BPSM_COMPACT_DELTA_MASK                               ((0b1 << RADIO_BPSM_COMPACT_DELTA_SIZE_BITS) - 1)
+// Number of delta payloads between two absolute ones.
+#define RADIO_BPSM_COMPACT_DELTA_COUNT_MAX                          7
+
+#define RADIO_BPSM_COMPACT_VOLTAGE_FIELD_COUNT                      3
+
 /*** RADIO BPSM local structures ***/
 
 /*******************************************************************/
@@ -51,6 +69,20 @@ typedef union {
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } RADIO_BPSM_ul_payload_electrical_t;
 
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+/*******************************************************************/
+typedef enum {
+    RADIO_BPSM_COMPACT_FIELD_HEADER = 0,
+    RADIO_BPSM_COMPACT_FIELD_CHARGE_STATUS,
+    RADIO_BPSM_COMPACT_FIELD_CHARGE_CONTROL_STATE,
+    RADIO_BPSM_COMPACT_FIELD_BACKUP_CONTROL_STATE,
+    RADIO_BPSM_COMPACT_FIELD_STORAGE_VOLTAGE,
+    RADIO_BPSM_COMPACT_FIELD_SOURCE_VOLTAGE,
+    RADIO_BPSM_COMPACT_FIELD_BACKUP_VOLTAGE,
+    RADIO_BPSM_COMPACT_FIELD_LAST
+} RADIO_BPSM_compact_field_t;
+#endif
+
 /*** BPSM local global variables ***/
 
 static const uint8_t RADIO_BPSM_REGISTERS_MONITORING[] = {
@@ -77,6 +109,107 @@ static const RADIO_BPSM_ul_payload_type_t RADIO_BPSM_UL_PAYLOAD_PATTERN[] = {
     RADIO_BPSM_UL_PAYLOAD_TYPE_MONITORING
 };
 
+static const RADIO_COMMON_data_type_t RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE[] = {
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE
+};
+
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+// Voltage fields carry absolute values or deltas depending on the schema.
+static const RADIO_CODEC_field_t RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_FIELDS[] = {
+    { RADIO_BPSM_COMPACT_FIELD_HEADER, 0, 8 },
+    { RADIO_BPSM_COMPACT_FIELD_CHARGE_STATUS, 8, 2 },
+    { RADIO_BPSM_COMPACT_FIELD_CHARGE_CONTROL_STATE, 10, 2 },
+    { RADIO_BPSM_COMPACT_FIELD_BACKUP_CONTROL_STATE, 12, 2 },
+    { RADIO_BPSM_COMPACT_FIELD_STORAGE_VOLTAGE, 14, RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS },
+    { RADIO_BPSM_COMPACT_FIELD_SOURCE_VOLTAGE, 25, RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS },
+    { RADIO_BPSM_COMPACT_FIELD_BACKUP_VOLTAGE, 36, RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS }
+};
+
+static const RADIO_CODEC_field_t RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_FIELDS[] = {
+    { RADIO_BPSM_COMPACT_FIELD_HEADER, 0, 8 },
+    { RADIO_BPSM_COMPACT_FIELD_CHARGE_STATUS, 8, 2 },
+    { RADIO_BPSM_COMPACT_FIELD_CHARGE_CONTROL_STATE, 10, 2 },
+    { RADIO_BPSM_COMPACT_FIELD_BACKUP_CONTROL_STATE, 12, 2 },
+    { RADIO_BPSM_COMPACT_FIELD_STORAGE_VOLTAGE, 14, RADIO_BPSM_COMPACT_DELTA_SIZE_BITS },
+    { RADIO_BPSM_COMPACT_FIELD_SOURCE_VOLTAGE, 20, RADIO_BPSM_COMPACT_DELTA_SIZE_BITS },
+    { RADIO_BPSM_COMPACT_FIELD_BACKUP_VOLTAGE, 26, RADIO_BPSM_COMPACT_DELTA_SIZE_BITS }
+};
+
+static const RADIO_CODEC_schema_t RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_FIELDS, RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SIZE);
+static const RADIO_CODEC_schema_t RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_FIELDS, RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_SIZE);
+
+/*** RADIO BPSM local functions ***/
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_BPSM_build_ul_payload_electrical_compact(RADIO_node_t* radio_node, uint8_t payload_type, uint32_t* bpsm_registers, RADIO_ul_payload_t* node_payload) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint32_t ul_payload_field[RADIO_BPSM_COMPACT_FIELD_LAST];
+    RADIO_ul_reference_t* reference = &(radio_node->ul_reference);
+    uint16_t voltage[RADIO_BPSM_COMPACT_VOLTAGE_FIELD_COUNT];
+    int32_t delta[RADIO_BPSM_COMPACT_VOLTAGE_FIELD_COUNT];
+    uint8_t delta_flag = 0;
+    uint8_t idx = 0;
+    // Quantize voltages.
+    voltage[0] = (uint16_t) RADIO_COMMON_get_compact_field(RADIO_COMMON_DATA_TYPE_VOLTAGE, SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_ANALOG_DATA_1], BPSM_REGISTER_ANALOG_DATA_1_MASK_STORAGE_VOLTAGE), RADIO_BPSM_COMPACT_VOLTAGE_LSB_MV, RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS);
+    voltage[1] = (uint16_t) RADIO_COMMON_get_compact_field(RADIO_COMMON_DATA_TYPE_VOLTAGE, SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_ANALOG_DATA_1], BPSM_REGISTER_ANALOG_DATA_1_MASK_SOURCE_VOLTAGE), RADIO_BPSM_COMPACT_VOLTAGE_LSB_MV, RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS);
+    voltage[2] = (uint16_t) RADIO_COMMON_get_compact_field(RADIO_COMMON_DATA_TYPE_VOLTAGE, SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_ANALOG_DATA_2], BPSM_REGISTER_ANALOG_DATA_2_MASK_BACKUP_VOLTAGE), RADIO_BPSM_COMPACT_VOLTAGE_LSB_MV, RADIO_BPSM_COMPACT_VOLTAGE_SIZE_BITS);
+    // Deltas are computed against the last absolute payload, so that a lost delta payload does not affect the next ones.
+    // This payload must have been transmitted, otherwise the deltas could not be decoded.
+    if (((reference->payload_type) == payload_type) && ((reference->transmitted_flag) != 0) && ((reference->delta_count) < RADIO_BPSM_COMPACT_DELTA_COUNT_MAX)) {
+        delta_flag = 1;
+        for (idx = 0; idx < RADIO_BPSM_COMPACT_VOLTAGE_FIELD_COUNT; idx++) {
+            delta[idx] = ((int32_t) voltage[idx]) - ((int32_t) (reference->value)[idx]);
+            // Unknown values and large steps require an absolute payload.
+            if ((voltage[idx] == RADIO_BPSM_COMPACT_VOLTAGE_ERROR_VALUE) || (((reference->value)[idx]) == RADIO_BPSM_COMPACT_VOLTAGE_ERROR_VALUE) || (delta[idx] < RADIO_BPSM_COMPACT_DELTA_MIN) || (delta[idx] > RADIO_BPSM_COMPACT_DELTA_MAX)) {
+                delta_flag = 0;
+                break;
+            }
+        }
+    }
+    // Common fields.
+    ul_payload_field[RADIO_BPSM_COMPACT_FIELD_CHARGE_STATUS] = SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_STATUS_1], BPSM_REGISTER_STATUS_1_MASK_CHST);
+    ul_payload_field[RADIO_BPSM_COMPACT_FIELD_CHARGE_CONTROL_STATE] = SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_STATUS_1], BPSM_REGISTER_STATUS_1_MASK_CHCS);
+    ul_payload_field[RADIO_BPSM_COMPACT_FIELD_BACKUP_CONTROL_STATE] = SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_STATUS_1], BPSM_REGISTER_STATUS_1_MASK_BKCS);
+    if (delta_flag != 0) {
+        // Build delta payload.
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_HEADER] = RADIO_COMMON_get_compact_header(RADIO_COMMON_COMPACT_ENCODING_DELTA);
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_STORAGE_VOLTAGE] = (((uint32_t) delta[0]) & RADIO_BPSM_COMPACT_DELTA_MASK);
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_SOURCE_VOLTAGE] = (((uint32_t) delta[1]) & RADIO_BPSM_COMPACT_DELTA_MASK);
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_BACKUP_VOLTAGE] = (((uint32_t) delta[2]) & RADIO_BPSM_COMPACT_DELTA_MASK);
+        status = RADIO_CODEC_pack(&RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_SCHEMA, (uint32_t*) ul_payload_field, (node_payload->payload));
+        if (status != RADIO_SUCCESS) goto errors;
+        node_payload->payload_size = RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_SIZE;
+        reference->delta_count++;
+    }
+    else {
+        // Build absolute payload.
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_HEADER] = RADIO_COMMON_get_compact_header(RADIO_COMMON_COMPACT_ENCODING_ABSOLUTE);
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_STORAGE_VOLTAGE] = voltage[0];
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_SOURCE_VOLTAGE] = voltage[1];
+        ul_payload_field[RADIO_BPSM_COMPACT_FIELD_BACKUP_VOLTAGE] = voltage[2];
+        status = RADIO_CODEC_pack(&RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SCHEMA, (uint32_t*) ul_payload_field, (node_payload->payload));
+        if (status != RADIO_SUCCESS) goto errors;
+        // Drop trailing backup voltage if it is unknown.
+        node_payload->payload_size = (voltage[2] == RADIO_BPSM_COMPACT_VOLTAGE_ERROR_VALUE) ? RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SIZE_NO_BACKUP : RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SIZE;
+        // Update reference.
+        reference->payload_type = payload_type;
+        reference->delta_count = 0;
+        reference->transmitted_flag = 0;
+        for (idx = 0; idx < RADIO_BPSM_COMPACT_VOLTAGE_FIELD_COUNT; idx++) {
+            (reference->value)[idx] = voltage[idx];
+        }
+    }
+errors:
+    return status;
+}
+#endif
+
 /*** RADIO BPSM functions ***/
 
 /*******************************************************************/
@@ -88,6 +221,9 @@ RADIO_status_t RADIO_BPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     uint32_t bpsm_registers[BPSM_REGISTER_ADDRESS_LAST];
     RADIO_BPSM_ul_payload_monitoring_t ul_payload_monitoring;
     RADIO_BPSM_ul_payload_electrical_t ul_payload_electrical;
+    uint32_t deadband_field[RADIO_UL_DEADBAND_FIELD_COUNT_MAX];
+    uint8_t send_required = 1;
+    uint8_t payload_type = 0;
     uint8_t idx = 0;
     // Check parameters.
     if ((radio_node == NULL) || (node_payload == NULL)) {
@@ -110,7 +246,9 @@ RADIO_status_t RADIO_BPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     // Directly exits if a common payload was computed.
     if ((node_payload->payload_size) > 0) goto errors;
     // Else use specific pattern of the node.
-    switch (RADIO_BPSM_UL_PAYLOAD_PATTERN[radio_node->payload_type_counter]) {
+    status = RADIO_COMMON_get_ul_payload_type(radio_node, (const uint8_t*) RADIO_BPSM_UL_PAYLOAD_PATTERN, sizeof(RADIO_BPSM_UL_PAYLOAD_PATTERN), RADIO_BPSM_UL_PAYLOAD_TYPE_LAST, &payload_type);
+    if (status != RADIO_SUCCESS) goto errors;
+    switch (payload_type) {
     case RADIO_BPSM_UL_PAYLOAD_TYPE_MONITORING:
         // Perform measurements.
         node_status = NODE_perform_measurements((radio_node->node), &access_status);
@@ -118,7 +256,7 @@ RADIO_status_t RADIO_BPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BPSM_REGISTERS_MONITORING, sizeof(RADIO_BPSM_REGISTERS_MONITORING), (uint32_t*) bpsm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BPSM_REGISTERS_MONITORING, sizeof(RADIO_BPSM_REGISTERS_MONITORING), (uint32_t*) bpsm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
         // Build monitoring payload.
@@ -137,7 +275,7 @@ RADIO_status_t RADIO_BPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BPSM_REGISTERS_ELECTRICAL, sizeof(RADIO_BPSM_REGISTERS_ELECTRICAL), (uint32_t*) bpsm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_BPSM_REGISTERS_ELECTRICAL, sizeof(RADIO_BPSM_REGISTERS_ELECTRICAL), (uint32_t*) bpsm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
         // Build data payload.
@@ -148,18 +286,49 @@ RADIO_status_t RADIO_BPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         ul_payload_electrical.charge_status = SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_STATUS_1], BPSM_REGISTER_STATUS_1_MASK_CHST);
         ul_payload_electrical.charge_control_state = SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_STATUS_1], BPSM_REGISTER_STATUS_1_MASK_CHCS);
         ul_payload_electrical.backup_control_state = SWREG_read_field(bpsm_registers[BPSM_REGISTER_ADDRESS_STATUS_1], BPSM_REGISTER_STATUS_1_MASK_BKCS);
+        // Skip payload if data did not change significantly.
+        deadband_field[0] = ul_payload_electrical.source_voltage;
+        deadband_field[1] = ul_payload_electrical.storage_voltage;
+        deadband_field[2] = ul_payload_electrical.backup_voltage;
+        deadband_field[3] = ul_payload_electrical.charge_status;
+        deadband_field[4] = ul_payload_electrical.charge_control_state;
+        deadband_field[5] = ul_payload_electrical.backup_control_state;
+        status = RADIO_COMMON_check_deadband(radio_node, payload_type, RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE, (uint32_t*) deadband_field, sizeof(RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE), &send_required);
+        if (status != RADIO_SUCCESS) goto errors;
+        if (send_required == 0) break;
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+        // Build compact payload.
+        status = _RADIO_BPSM_build_ul_payload_electrical_compact(radio_node, payload_type, (uint32_t*) bpsm_registers, node_payload);
+        if (status != RADIO_SUCCESS) goto errors;
+#else
         // Copy payload.
         for (idx = 0; idx < RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_SIZE; idx++) {
             (node_payload->payload)[idx] = ul_payload_electrical.frame[idx];
         }
         node_payload->payload_size = RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_SIZE;
+#endif
         break;
     default:
         status = RADIO_ERROR_UL_NODE_PAYLOAD_TYPE;
         goto errors;
     }
     // Increment payload type counter.
-    radio_node->payload_type_counter = (((radio_node->payload_type_counter) + 1) % sizeof(RADIO_BPSM_UL_PAYLOAD_PATTERN));
+    RADIO_COMMON_increment_ul_payload_type(radio_node, sizeof(RADIO_BPSM_UL_PAYLOAD_PATTERN));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_BPSM_check_schemas(void) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+    // Check compact payloads schemas.
+    status = RADIO_CODEC_check_schema(&RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_COMPACT_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
+    status = RADIO_CODEC_check_schema(&RADIO_BPSM_UL_PAYLOAD_ELECTRICAL_DELTA_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
 errors:
+#endif
     return status;
 }
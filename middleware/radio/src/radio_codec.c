@@ -0,0 +1,129 @@
+/*
+ * radio_codec.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "radio_codec.h"
+
+#include "radio.h"
+#include "types.h"
+
+/*** RADIO CODEC local macros ***/
+
+#define RADIO_CODEC_FIELD_SIZE_BITS_MAX     32
+
+/*** RADIO CODEC functions ***/
+
+/*******************************************************************/
+RADIO_status_t RADIO_CODEC_check_schema(const RADIO_CODEC_schema_t* schema) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    const RADIO_CODEC_field_t* field = NULL;
+    uint8_t idx = 0;
+    // Check parameters.
+    if (schema == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((schema->field_list) == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Check fields bounds.
+    for (idx = 0; idx < (schema->field_count); idx++) {
+        field = &((schema->field_list)[idx]);
+        if (((field->size_bits) == 0) || ((field->size_bits) > RADIO_CODEC_FIELD_SIZE_BITS_MAX) || (((uint16_t) (field->offset_bits) + (uint16_t) (field->size_bits)) > ((uint16_t) (schema->frame_size_bytes) << 3))) {
+            status = RADIO_ERROR_CODEC_SCHEMA;
+            goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_CODEC_pack(const RADIO_CODEC_schema_t* schema, uint32_t* field_value, uint8_t* frame) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    const RADIO_CODEC_field_t* field = NULL;
+    uint32_t value = 0;
+    uint8_t remaining_bits = 0;
+    uint8_t last_bit = 0;
+    uint8_t shift = 0;
+    uint8_t chunk_bits = 0;
+    uint8_t mask = 0;
+    uint8_t idx = 0;
+    // Check parameters (schema bounds are checked once at init).
+    if ((schema == NULL) || (field_value == NULL) || (frame == NULL)) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset frame.
+    for (idx = 0; idx < (schema->frame_size_bytes); idx++) {
+        frame[idx] = 0x00;
+    }
+    // Fields loop.
+    for (idx = 0; idx < (schema->field_count); idx++) {
+        field = &((schema->field_list)[idx]);
+        value = field_value[field->field_index];
+        remaining_bits = (field->size_bits);
+        // Write from the least significant bits, one byte at a time.
+        while (remaining_bits > 0) {
+            last_bit = ((field->offset_bits) + remaining_bits - 1);
+            shift = (7 - (last_bit & 0x07));
+            chunk_bits = (8 - shift);
+            if (chunk_bits > remaining_bits) {
+                chunk_bits = remaining_bits;
+            }
+            mask = (uint8_t) (((0b1 << chunk_bits) - 1) << shift);
+            frame[last_bit >> 3] = (uint8_t) ((frame[last_bit >> 3] & (~mask)) | ((value << shift) & mask));
+            value >>= chunk_bits;
+            remaining_bits -= chunk_bits;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_CODEC_unpack(const RADIO_CODEC_schema_t* schema, uint8_t* frame, uint32_t* field_value) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    const RADIO_CODEC_field_t* field = NULL;
+    uint32_t value = 0;
+    uint8_t value_bits = 0;
+    uint8_t remaining_bits = 0;
+    uint8_t last_bit = 0;
+    uint8_t shift = 0;
+    uint8_t chunk_bits = 0;
+    uint8_t idx = 0;
+    // Check parameters (schema bounds are checked once at init).
+    if ((schema == NULL) || (field_value == NULL) || (frame == NULL)) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Fields loop.
+    for (idx = 0; idx < (schema->field_count); idx++) {
+        field = &((schema->field_list)[idx]);
+        value = 0;
+        value_bits = 0;
+        remaining_bits = (field->size_bits);
+        // Read from the least significant bits, one byte at a time.
+        while (remaining_bits > 0) {
+            last_bit = ((field->offset_bits) + remaining_bits - 1);
+            shift = (7 - (last_bit & 0x07));
+            chunk_bits = (8 - shift);
+            if (chunk_bits > remaining_bits) {
+                chunk_bits = remaining_bits;
+            }
+            value |= (((uint32_t) ((frame[last_bit >> 3] >> shift) & ((0b1 << chunk_bits) - 1))) << value_bits);
+            value_bits += chunk_bits;
+            remaining_bits -= chunk_bits;
+        }
+        field_value[field->field_index] = value;
+    }
+errors:
+    return status;
+}
@@ -10,34 +10,55 @@
 #include "common_registers.h"
 #include "node.h"
 #include "radio.h"
+#include "radio_codec.h"
 #include "rcc_registers.h"
+#include "rtc.h"
 #include "strings.h"
 #include "swreg.h"
 #include "types.h"
 #include "una.h"
+#include "una_dmm.h"
 #include "version.h"
 
 /*** RADIO COMMON local macros ***/
 
-#define RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_SIZE         8
-#define RADIO_COMMON_UL_PAYLOAD_STARTUP_SIZE            8
-#define RADIO_COMMON_UL_PAYLOAD_ERROR_STACK_SIZE        10
+#define RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_HEADER_SIZE  2
+#define RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_RESULT_SIZE  2
+#define RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_VALUE_SIZE   6
+#define RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_PADDING      0xFF
 
 #define RADIO_COMMON_UL_PAYLOAD_ERROR_STACK_MAX_COUNT   4
 
+#define RADIO_COMMON_DEADBAND_CURRENT_FACTOR            1000
+
+#define RADIO_COMMON_UL_PAYLOAD_COMPACT_VERSION         1
+
+#define RADIO_COMMON_COMPACT_FIELD_SIZE_BITS_MAX        16
+
 /*** RADIO COMMON local structures ***/
 
 /*******************************************************************/
-typedef union {
-    uint8_t frame[RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_SIZE];
-    struct {
-        unsigned marker :4;
-        unsigned downlink_hash :12;
-        unsigned reg_addr :8;
-        unsigned reg_value :32;
-        unsigned node_access_status :8;
-    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
-} RADIO_COMMON_ul_payload_action_log_t;
+// Action log format: header (marker and downlink hash) followed by one entry per action (register address, access status and read value).
+// An entry carries the 32-bits value only for successful reads (6 bytes), otherwise it is 2 bytes long.
+// The startup and error stack sizes are never used: a log of the startup size is padded with one trailing byte.
+// The log is therefore always 4, 6 or 9 bytes long, and a single remaining byte after the last entry is padding.
+typedef enum {
+    RADIO_COMMON_ACTION_LOG_FIELD_MARKER = 0,
+    RADIO_COMMON_ACTION_LOG_FIELD_DOWNLINK_HASH,
+    RADIO_COMMON_ACTION_LOG_FIELD_REG_ADDR,
+    RADIO_COMMON_ACTION_LOG_FIELD_NODE_ACCESS_STATUS,
+    RADIO_COMMON_ACTION_LOG_FIELD_REG_VALUE,
+    RADIO_COMMON_ACTION_LOG_FIELD_LAST
+} RADIO_COMMON_action_log_field_t;
+
+/*******************************************************************/
+typedef enum {
+    RADIO_COMMON_ALARM_FIELD_MARKER = 0,
+    RADIO_COMMON_ALARM_FIELD_RULE_INDEX,
+    RADIO_COMMON_ALARM_FIELD_REG_ADDR,
+    RADIO_COMMON_ALARM_FIELD_REG_VALUE,
+    RADIO_COMMON_ALARM_FIELD_LAST
+} RADIO_COMMON_alarm_field_t;
 
 /*******************************************************************/
 typedef union {
@@ -52,6 +73,36 @@ typedef union {
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } RADIO_COMMON_ul_payload_startup_t;
 
+/*******************************************************************/
+typedef union {
+    uint8_t value;
+    struct {
+        unsigned marker :4;
+        unsigned version :2;
+        unsigned encoding :2;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} RADIO_COMMON_compact_header_t;
+
+/*******************************************************************/
+typedef struct {
+    UNA_get_physical_data_t get_physical_data_pfn;
+    uint32_t error_value;
+    int32_t factor;
+    uint8_t signed_flag;
+} RADIO_COMMON_data_format_t;
+
+/*******************************************************************/
+typedef struct {
+    int32_t absolute;
+    int32_t relative_percent;
+} RADIO_COMMON_deadband_t;
+
+/*******************************************************************/
+typedef struct {
+    RADIO_COMMON_deadband_t deadband[RADIO_COMMON_DATA_TYPE_LAST];
+    uint32_t heartbeat_period_seconds;
+} RADIO_COMMON_context_t;
+
 /*** COMMON local global variables ***/
 
 static const uint8_t RADIO_COMMON_REGISTERS_STARTUP[] = {
@@ -60,23 +111,100 @@ static const uint8_t RADIO_COMMON_REGISTERS_STARTUP[] = {
     COMMON_REGISTER_ADDRESS_STATUS_0
 };
 
+static const RADIO_CODEC_field_t RADIO_COMMON_ACTION_LOG_HEADER_FIELDS[] = {
+    { RADIO_COMMON_ACTION_LOG_FIELD_MARKER, 0, 4 },
+    { RADIO_COMMON_ACTION_LOG_FIELD_DOWNLINK_HASH, 4, 12 }
+};
+
+static const RADIO_CODEC_field_t RADIO_COMMON_ACTION_LOG_RESULT_FIELDS[] = {
+    { RADIO_COMMON_ACTION_LOG_FIELD_REG_ADDR, 0, 8 },
+    { RADIO_COMMON_ACTION_LOG_FIELD_NODE_ACCESS_STATUS, 8, 8 }
+};
+
+static const RADIO_CODEC_field_t RADIO_COMMON_ACTION_LOG_VALUE_FIELDS[] = {
+    { RADIO_COMMON_ACTION_LOG_FIELD_REG_ADDR, 0, 8 },
+    { RADIO_COMMON_ACTION_LOG_FIELD_NODE_ACCESS_STATUS, 8, 8 },
+    { RADIO_COMMON_ACTION_LOG_FIELD_REG_VALUE, 16, 32 }
+};
+
+static const RADIO_CODEC_field_t RADIO_COMMON_ALARM_FIELDS[] = {
+    { RADIO_COMMON_ALARM_FIELD_MARKER, 0, 4 },
+    { RADIO_COMMON_ALARM_FIELD_RULE_INDEX, 4, 4 },
+    { RADIO_COMMON_ALARM_FIELD_REG_ADDR, 8, 8 },
+    { RADIO_COMMON_ALARM_FIELD_REG_VALUE, 16, 32 }
+};
+
+static const RADIO_CODEC_schema_t RADIO_COMMON_ACTION_LOG_HEADER_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_COMMON_ACTION_LOG_HEADER_FIELDS, RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_HEADER_SIZE);
+static const RADIO_CODEC_schema_t RADIO_COMMON_ACTION_LOG_RESULT_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_COMMON_ACTION_LOG_RESULT_FIELDS, RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_RESULT_SIZE);
+static const RADIO_CODEC_schema_t RADIO_COMMON_ACTION_LOG_VALUE_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_COMMON_ACTION_LOG_VALUE_FIELDS, RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_VALUE_SIZE);
+static const RADIO_CODEC_schema_t RADIO_COMMON_ALARM_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_COMMON_ALARM_FIELDS, RADIO_COMMON_UL_PAYLOAD_ALARM_SIZE);
+
+static const RADIO_COMMON_data_format_t RADIO_COMMON_DATA_FORMAT[RADIO_COMMON_DATA_TYPE_LAST] = {
+    { &UNA_get_mv, UNA_VOLTAGE_ERROR_VALUE, 1, 0 },
+    { &UNA_get_ua, UNA_CURRENT_ERROR_VALUE, RADIO_COMMON_DEADBAND_CURRENT_FACTOR, 1 },
+    { &UNA_get_tenth_degrees, UNA_TEMPERATURE_ERROR_VALUE, 1, 1 },
+    { NULL, 0, 1, 0 }
+};
+
+static RADIO_COMMON_context_t radio_common_ctx = {
+    .deadband = { [0 ... (RADIO_COMMON_DATA_TYPE_LAST - 1)] = { 0, 0 } },
+    .heartbeat_period_seconds = 0
+};
+
 /*** RADIO COMMON local functions ***/
 
+/*******************************************************************/
+static uint8_t _RADIO_COMMON_check_deadband_field(RADIO_COMMON_data_type_t data_type, uint32_t previous_value, uint32_t value) {
+    // Local variables.
+    uint8_t significant = 0;
+    int32_t previous_physical_data = 0;
+    int32_t physical_data = 0;
+    int32_t delta = 0;
+    int32_t absolute = 0;
+    int32_t relative_percent = 0;
+    // Check equality.
+    if (value == previous_value) goto errors;
+    significant = 1;
+    // States and error values are always significant.
+    if ((data_type >= RADIO_COMMON_DATA_TYPE_LAST) || (RADIO_COMMON_DATA_FORMAT[data_type].get_physical_data_pfn == NULL)) goto errors;
+    if ((value == RADIO_COMMON_DATA_FORMAT[data_type].error_value) || (previous_value == RADIO_COMMON_DATA_FORMAT[data_type].error_value)) goto errors;
+    // Convert to physical data.
+    previous_physical_data = RADIO_COMMON_DATA_FORMAT[data_type].get_physical_data_pfn(previous_value);
+    physical_data = RADIO_COMMON_DATA_FORMAT[data_type].get_physical_data_pfn(value);
+    delta = (physical_data > previous_physical_data) ? (physical_data - previous_physical_data) : (previous_physical_data - physical_data);
+    if (previous_physical_data < 0) {
+        previous_physical_data = (-previous_physical_data);
+    }
+    absolute = (radio_common_ctx.deadband[data_type].absolute * RADIO_COMMON_DATA_FORMAT[data_type].factor);
+    relative_percent = radio_common_ctx.deadband[data_type].relative_percent;
+    // Any change is significant if no deadband is configured.
+    if ((absolute == 0) && (relative_percent == 0)) goto errors;
+    // Check deadbands.
+    if ((absolute != 0) && (delta > absolute)) goto errors;
+    if ((relative_percent != 0) && (delta > ((previous_physical_data * relative_percent) / 100))) goto errors;
+    significant = 0;
+errors:
+    return significant;
+}
+
 /*******************************************************************/
 static RADIO_status_t _RADIO_COMMON_build_ul_node_payload_startup(RADIO_node_t* radio_node, RADIO_ul_payload_t* node_payload, uint32_t* node_registers) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
     NODE_status_t node_status = NODE_SUCCESS;
     UNA_access_status_t access_status;
+    UNA_access_status_t access_status_list[sizeof(RADIO_COMMON_REGISTERS_STARTUP)];
     RADIO_COMMON_ul_payload_startup_t ul_payload_startup;
     uint8_t idx = 0;
     // Reset payload size.
     node_payload->payload_size = 0;
     // Read related registers.
-    node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_COMMON_REGISTERS_STARTUP, sizeof(RADIO_COMMON_REGISTERS_STARTUP), node_registers, &access_status);
+    node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_COMMON_REGISTERS_STARTUP, sizeof(RADIO_COMMON_REGISTERS_STARTUP), node_registers, (UNA_access_status_t*) access_status_list, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
-    // Check read status.
-    if (access_status.flags != 0) goto errors;
+    // Startup payload is only sent when all registers were read, since the boot flag is cleared afterwards.
+    for (idx = 0; idx < sizeof(RADIO_COMMON_REGISTERS_STARTUP); idx++) {
+        if (access_status_list[idx].flags != 0) goto errors;
+    }
     // Build data payload.
     ul_payload_startup.reset_reason = SWREG_read_field(node_registers[COMMON_REGISTER_ADDRESS_STATUS_0], COMMON_REGISTER_STATUS_0_MASK_RESET_FLAGS);
     ul_payload_startup.major_version = SWREG_read_field(node_registers[COMMON_REGISTER_ADDRESS_SW_VERSION_0], COMMON_REGISTER_SW_VERSION_0_MASK_MAJOR);
@@ -141,8 +269,9 @@ RADIO_status_t RADIO_COMMON_check_event_driven_payloads(RADIO_node_t* radio_node
         status = RADIO_ERROR_NULL_PARAMETER;
         goto errors;
     }
-    // Reset payload size.
+    // Reset payload size and event flag.
     node_payload->payload_size = 0;
+    radio_node->ul_event_pending = 0;
     // Read status register.
     node_status = NODE_read_register((radio_node->node), COMMON_REGISTER_ADDRESS_STATUS_0, &(node_registers[COMMON_REGISTER_ADDRESS_STATUS_0]), &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
@@ -150,14 +279,24 @@ RADIO_status_t RADIO_COMMON_check_event_driven_payloads(RADIO_node_t* radio_node
     if (access_status.flags != 0) goto errors;
     // Update local value.
     reg_status_0 = node_registers[COMMON_REGISTER_ADDRESS_STATUS_0];
+    // Serve the node first at next uplink while a flag remains set.
+    if ((SWREG_read_field(reg_status_0, COMMON_REGISTER_STATUS_0_MASK_BF) != 0) || (SWREG_read_field(reg_status_0, COMMON_REGISTER_STATUS_0_MASK_ESF) != 0)) {
+        radio_node->ul_event_pending = 1;
+    }
     // Read boot flag.
     if (SWREG_read_field(reg_status_0, COMMON_REGISTER_STATUS_0_MASK_BF) != 0) {
         // Compute startup payload.
         status = _RADIO_COMMON_build_ul_node_payload_startup(radio_node, node_payload, node_registers);
         if (status != RADIO_SUCCESS) goto errors;
+        // Keep boot flag if the startup payload could not be built.
+        if ((node_payload->payload_size) == 0) goto errors;
         // Clear boot flag.
         node_status = NODE_write_register((radio_node->node), COMMON_REGISTER_ADDRESS_CONTROL_0, COMMON_REGISTER_CONTROL_0_MASK_BFC, COMMON_REGISTER_CONTROL_0_MASK_BFC, &access_status);
         NODE_exit_error(RADIO_ERROR_BASE_NODE);
+        // Only the error stack remains to be reported.
+        if ((access_status.flags == 0) && (SWREG_read_field(reg_status_0, COMMON_REGISTER_STATUS_0_MASK_ESF) == 0)) {
+            radio_node->ul_event_pending = 0;
+        }
     }
     else {
         if (SWREG_read_field(reg_status_0, COMMON_REGISTER_STATUS_0_MASK_ESF) != 0) {
@@ -183,12 +322,120 @@ errors:
 }
 
 /*******************************************************************/
-RADIO_status_t RADIO_COMMON_build_ul_node_payload_action_log(RADIO_node_action_t* node_action, RADIO_ul_payload_t* node_payload) {
+RADIO_status_t RADIO_COMMON_get_ul_payload_type(RADIO_node_t* radio_node, const uint8_t* default_pattern, uint8_t default_pattern_size, uint8_t payload_type_last, uint8_t* payload_type) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t pattern_size = 0;
+    // Check parameters.
+    if ((radio_node == NULL) || (default_pattern == NULL) || (payload_type == NULL)) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (default_pattern_size == 0) {
+        status = RADIO_ERROR_UL_NODE_PAYLOAD_TYPE;
+        goto errors;
+    }
+    // Select pattern.
+    pattern_size = ((radio_node->ul_pattern_size) == 0) ? default_pattern_size : (radio_node->ul_pattern_size);
+    if ((radio_node->payload_type_counter) >= pattern_size) {
+        radio_node->payload_type_counter = 0;
+    }
+    // Read runtime pattern if configured.
+    if ((radio_node->ul_pattern_size) != 0) {
+        (*payload_type) = (uint8_t) (((radio_node->ul_pattern) >> ((radio_node->payload_type_counter) * UNA_DMM_RADIO_NODE_PATTERN_ENTRY_SIZE_BITS)) & ((0b1 << UNA_DMM_RADIO_NODE_PATTERN_ENTRY_SIZE_BITS) - 1));
+        // Use default pattern if the type does not exist on the board.
+        if ((*payload_type) < payload_type_last) goto errors;
+    }
+    (*payload_type) = default_pattern[(radio_node->payload_type_counter) % default_pattern_size];
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void RADIO_COMMON_increment_ul_payload_type(RADIO_node_t* radio_node, uint8_t default_pattern_size) {
+    // Local variables.
+    uint8_t pattern_size = 0;
+    // Check parameters.
+    if (radio_node == NULL) goto errors;
+    // Select pattern.
+    pattern_size = ((radio_node->ul_pattern_size) == 0) ? default_pattern_size : (radio_node->ul_pattern_size);
+    if (pattern_size == 0) goto errors;
+    // Increment counter.
+    radio_node->payload_type_counter = (((radio_node->payload_type_counter) + 1) % pattern_size);
+errors:
+    return;
+}
+
+/*******************************************************************/
+void RADIO_COMMON_set_deadband_configuration(uint32_t reg_deadband_0, uint32_t reg_deadband_1, uint32_t reg_deadband_2) {
+    // Voltage.
+    radio_common_ctx.deadband[RADIO_COMMON_DATA_TYPE_VOLTAGE].absolute = (int32_t) SWREG_read_field(reg_deadband_0, UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_VOLTAGE_ABSOLUTE);
+    radio_common_ctx.deadband[RADIO_COMMON_DATA_TYPE_VOLTAGE].relative_percent = (int32_t) SWREG_read_field(reg_deadband_0, UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_VOLTAGE_RELATIVE);
+    // Current.
+    radio_common_ctx.deadband[RADIO_COMMON_DATA_TYPE_CURRENT].absolute = (int32_t) SWREG_read_field(reg_deadband_1, UNA_DMM_REGISTER_RADIO_DEADBAND_1_MASK_CURRENT_ABSOLUTE);
+    radio_common_ctx.deadband[RADIO_COMMON_DATA_TYPE_CURRENT].relative_percent = (int32_t) SWREG_read_field(reg_deadband_1, UNA_DMM_REGISTER_RADIO_DEADBAND_1_MASK_CURRENT_RELATIVE);
+    // Temperature.
+    radio_common_ctx.deadband[RADIO_COMMON_DATA_TYPE_TEMPERATURE].absolute = (int32_t) SWREG_read_field(reg_deadband_2, UNA_DMM_REGISTER_RADIO_DEADBAND_2_MASK_TEMPERATURE_ABSOLUTE);
+    radio_common_ctx.deadband[RADIO_COMMON_DATA_TYPE_TEMPERATURE].relative_percent = (int32_t) SWREG_read_field(reg_deadband_2, UNA_DMM_REGISTER_RADIO_DEADBAND_2_MASK_TEMPERATURE_RELATIVE);
+    // Heartbeat (zero disables deadband reporting).
+    radio_common_ctx.heartbeat_period_seconds = 0;
+    if (SWREG_read_field(reg_deadband_0, UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_HEARTBEAT_PERIOD) != 0) {
+        radio_common_ctx.heartbeat_period_seconds = UNA_get_seconds(SWREG_read_field(reg_deadband_0, UNA_DMM_REGISTER_RADIO_DEADBAND_0_MASK_HEARTBEAT_PERIOD));
+    }
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_COMMON_check_deadband(RADIO_node_t* radio_node, uint8_t payload_type, const RADIO_COMMON_data_type_t* data_type_list, uint32_t* field_list, uint8_t field_list_size, uint8_t* send_required) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
-    RADIO_COMMON_ul_payload_action_log_t ul_payload_action_log;
+    RADIO_deadband_t* deadband = NULL;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
     uint8_t idx = 0;
     // Check parameters.
+    if ((radio_node == NULL) || (data_type_list == NULL) || (field_list == NULL) || (send_required == NULL)) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (field_list_size > RADIO_UL_DEADBAND_FIELD_COUNT_MAX) {
+        status = RADIO_ERROR_UL_NODE_PAYLOAD_SIZE_OVERFLOW;
+        goto errors;
+    }
+    // Send by default.
+    (*send_required) = 1;
+    // Directly exit if deadband reporting is disabled.
+    if (radio_common_ctx.heartbeat_period_seconds == 0) goto errors;
+    deadband = &((radio_node->ul_deadband)[payload_type % RADIO_UL_DEADBAND_SLOT_COUNT]);
+    // Compare with last sent values, unless the heartbeat period is elapsed.
+    if (((deadband->payload_type) == payload_type) && (uptime_seconds < ((deadband->time_seconds) + radio_common_ctx.heartbeat_period_seconds))) {
+        (*send_required) = 0;
+        for (idx = 0; idx < field_list_size; idx++) {
+            if (_RADIO_COMMON_check_deadband_field(data_type_list[idx], (uint32_t) ((deadband->value)[idx]), field_list[idx]) != 0) {
+                (*send_required) = 1;
+                break;
+            }
+        }
+    }
+    // Update last sent values.
+    if ((*send_required) != 0) {
+        (deadband->payload_type) = payload_type;
+        (deadband->time_seconds) = uptime_seconds;
+        for (idx = 0; idx < field_list_size; idx++) {
+            (deadband->value)[idx] = (uint16_t) field_list[idx];
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_COMMON_add_ul_node_payload_action_log(RADIO_node_action_t* node_action, RADIO_ul_payload_t* node_payload, uint8_t payload_size_max) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    const RADIO_CODEC_schema_t* entry_schema = &RADIO_COMMON_ACTION_LOG_RESULT_SCHEMA;
+    uint32_t action_log_field[RADIO_COMMON_ACTION_LOG_FIELD_LAST];
+    uint8_t header_size = 0;
+    uint8_t new_payload_size = 0;
+    // Check parameters.
     if ((node_payload == NULL) || (node_action == NULL)) {
         status = RADIO_ERROR_NULL_PARAMETER;
         goto errors;
@@ -197,17 +444,130 @@ RADIO_status_t RADIO_COMMON_build_ul_node_payload_action_log(RADIO_node_action_t
         status = RADIO_ERROR_NULL_PARAMETER;
         goto errors;
     }
-    // Build frame.
-    ul_payload_action_log.marker = 0b1111;
-    ul_payload_action_log.downlink_hash = ((node_action->downlink_hash) & 0x00000FFF);
-    ul_payload_action_log.reg_addr = (node_action->reg_addr);
-    ul_payload_action_log.reg_value = (node_action->reg_value);
-    ul_payload_action_log.node_access_status = ((node_action->access_status).all);
-    // Copy payload.
-    for (idx = 0; idx < RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_SIZE; idx++) {
-        (node_payload->payload)[idx] = ul_payload_action_log.frame[idx];
+    // Writes are always logged without value (the register is not read back): only successful reads carry the register value.
+    if ((((node_action->access_status).type) == UNA_ACCESS_TYPE_READ) && (((node_action->access_status).flags) == 0)) {
+        entry_schema = &RADIO_COMMON_ACTION_LOG_VALUE_SCHEMA;
+    }
+    // Check remaining size.
+    if (payload_size_max > RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_SIZE_MAX) {
+        payload_size_max = RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_SIZE_MAX;
+    }
+    header_size = ((node_payload->payload_size) == 0) ? RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_HEADER_SIZE : 0;
+    new_payload_size = ((node_payload->payload_size) + header_size + (entry_schema->frame_size_bytes));
+    // Do not use the startup payload size.
+    if (new_payload_size == RADIO_COMMON_UL_PAYLOAD_STARTUP_SIZE) {
+        new_payload_size++;
+    }
+    if (new_payload_size > payload_size_max) {
+        status = RADIO_ERROR_UL_NODE_PAYLOAD_SIZE_OVERFLOW;
+        goto errors;
+    }
+    // Build header.
+    if (header_size != 0) {
+        action_log_field[RADIO_COMMON_ACTION_LOG_FIELD_MARKER] = RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_MARKER;
+        action_log_field[RADIO_COMMON_ACTION_LOG_FIELD_DOWNLINK_HASH] = ((node_action->downlink_hash) & 0x00000FFF);
+        status = RADIO_CODEC_pack(&RADIO_COMMON_ACTION_LOG_HEADER_SCHEMA, (uint32_t*) action_log_field, (node_payload->payload));
+        if (status != RADIO_SUCCESS) goto errors;
+        node_payload->payload_size = header_size;
+    }
+    // Append entry.
+    action_log_field[RADIO_COMMON_ACTION_LOG_FIELD_REG_ADDR] = (node_action->reg_addr);
+    action_log_field[RADIO_COMMON_ACTION_LOG_FIELD_NODE_ACCESS_STATUS] = ((node_action->access_status).all);
+    action_log_field[RADIO_COMMON_ACTION_LOG_FIELD_REG_VALUE] = (node_action->reg_value);
+    status = RADIO_CODEC_pack(entry_schema, (uint32_t*) action_log_field, &((node_payload->payload)[node_payload->payload_size]));
+    if (status != RADIO_SUCCESS) goto errors;
+    node_payload->payload_size += (entry_schema->frame_size_bytes);
+    // Add padding byte if needed (no other entry can be appended after it).
+    if ((node_payload->payload_size) < new_payload_size) {
+        (node_payload->payload)[node_payload->payload_size] = RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_PADDING;
+        node_payload->payload_size++;
     }
-    node_payload->payload_size = RADIO_COMMON_UL_PAYLOAD_ACTION_LOG_SIZE;
 errors:
     return status;
 }
+
+/*******************************************************************/
+RADIO_status_t RADIO_COMMON_build_ul_node_payload_alarm(uint8_t rule_index, uint8_t reg_addr, uint32_t reg_value, RADIO_ul_payload_t* node_payload) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint32_t alarm_field[RADIO_COMMON_ALARM_FIELD_LAST];
+    // Check parameters.
+    if (node_payload == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((node_payload->payload) == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Build frame.
+    alarm_field[RADIO_COMMON_ALARM_FIELD_MARKER] = RADIO_COMMON_UL_PAYLOAD_ALARM_MARKER;
+    alarm_field[RADIO_COMMON_ALARM_FIELD_RULE_INDEX] = (rule_index & 0x0F);
+    alarm_field[RADIO_COMMON_ALARM_FIELD_REG_ADDR] = reg_addr;
+    alarm_field[RADIO_COMMON_ALARM_FIELD_REG_VALUE] = reg_value;
+    status = RADIO_CODEC_pack(&RADIO_COMMON_ALARM_SCHEMA, (uint32_t*) alarm_field, (node_payload->payload));
+    if (status != RADIO_SUCCESS) goto errors;
+    node_payload->payload_size = RADIO_COMMON_UL_PAYLOAD_ALARM_SIZE;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_COMMON_check_schemas(void) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    // Check all payloads schemas.
+    status = RADIO_CODEC_check_schema(&RADIO_COMMON_ACTION_LOG_HEADER_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
+    status = RADIO_CODEC_check_schema(&RADIO_COMMON_ACTION_LOG_RESULT_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
+    status = RADIO_CODEC_check_schema(&RADIO_COMMON_ACTION_LOG_VALUE_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
+    status = RADIO_CODEC_check_schema(&RADIO_COMMON_ALARM_SCHEMA);
+    if (status != RADIO_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+uint8_t RADIO_COMMON_get_compact_header(RADIO_COMMON_compact_encoding_t encoding) {
+    // Local variables.
+    RADIO_COMMON_compact_header_t compact_header;
+    // Build header.
+    compact_header.marker = RADIO_COMMON_UL_PAYLOAD_COMPACT_MARKER;
+    compact_header.version = RADIO_COMMON_UL_PAYLOAD_COMPACT_VERSION;
+    compact_header.encoding = (encoding & 0x03);
+    return (compact_header.value);
+}
+
+/*******************************************************************/
+uint32_t RADIO_COMMON_get_compact_field(RADIO_COMMON_data_type_t data_type, uint32_t value, int32_t lsb, uint8_t size_bits) {
+    // Local variables.
+    uint32_t compact_error_value = 0;
+    uint32_t compact_field = 0;
+    int32_t physical_data = 0;
+    // Check parameters.
+    if ((size_bits == 0) || (size_bits > RADIO_COMMON_COMPACT_FIELD_SIZE_BITS_MAX)) goto errors;
+    // All bits set is reserved for unknown values.
+    compact_error_value = ((0b1 << size_bits) - 1);
+    compact_field = compact_error_value;
+    if ((data_type >= RADIO_COMMON_DATA_TYPE_LAST) || (RADIO_COMMON_DATA_FORMAT[data_type].get_physical_data_pfn == NULL) || (lsb <= 0)) goto errors;
+    if (value == RADIO_COMMON_DATA_FORMAT[data_type].error_value) goto errors;
+    // Quantize physical data with rounding.
+    physical_data = RADIO_COMMON_DATA_FORMAT[data_type].get_physical_data_pfn(value);
+    physical_data = (physical_data >= 0) ? ((physical_data + (lsb >> 1)) / lsb) : ((physical_data - (lsb >> 1)) / lsb);
+    // Use offset binary for signed data types.
+    if (RADIO_COMMON_DATA_FORMAT[data_type].signed_flag != 0) {
+        physical_data += (int32_t) (0b1 << (size_bits - 1));
+    }
+    // Saturate.
+    if (physical_data < 0) {
+        physical_data = 0;
+    }
+    if (physical_data >= (int32_t) compact_error_value) {
+        physical_data = (int32_t) (compact_error_value - 1);
+    }
+    compact_field = (uint32_t) physical_data;
+errors:
+    return compact_field;
+}
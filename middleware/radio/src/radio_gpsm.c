@@ -59,6 +59,7 @@ RADIO_status_t RADIO_GPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     UNA_access_status_t access_status;
     uint32_t gpsm_registers[GPSM_REGISTER_ADDRESS_LAST];
     RADIO_GPSM_ul_payload_monitoring_t ul_payload_monitoring;
+    uint8_t payload_type = 0;
     uint8_t idx = 0;
     // Check parameters.
     if ((radio_node == NULL) || (node_payload == NULL)) {
@@ -81,7 +82,9 @@ RADIO_status_t RADIO_GPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     // Directly exits if a common payload was computed.
     if ((node_payload->payload_size) > 0) goto errors;
     // Else use specific pattern of the node.
-    switch (RADIO_GPSM_UL_PAYLOAD_PATTERN[radio_node->payload_type_counter]) {
+    status = RADIO_COMMON_get_ul_payload_type(radio_node, (const uint8_t*) RADIO_GPSM_UL_PAYLOAD_PATTERN, sizeof(RADIO_GPSM_UL_PAYLOAD_PATTERN), RADIO_GPSM_UL_PAYLOAD_TYPE_LAST, &payload_type);
+    if (status != RADIO_SUCCESS) goto errors;
+    switch (payload_type) {
     case RADIO_GPSM_UL_PAYLOAD_TYPE_MONITORING:
         // Perform measurements.
         node_status = NODE_perform_measurements((radio_node->node), &access_status);
@@ -89,7 +92,7 @@ RADIO_status_t RADIO_GPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_GPSM_REGISTERS_MONITORING, sizeof(RADIO_GPSM_REGISTERS_MONITORING), (uint32_t*) gpsm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_GPSM_REGISTERS_MONITORING, sizeof(RADIO_GPSM_REGISTERS_MONITORING), (uint32_t*) gpsm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
         // Build monitoring payload.
@@ -109,7 +112,7 @@ RADIO_status_t RADIO_GPSM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         goto errors;
     }
     // Increment payload type counter.
-    radio_node->payload_type_counter = (((radio_node->payload_type_counter) + 1) % sizeof(RADIO_GPSM_UL_PAYLOAD_PATTERN));
+    RADIO_COMMON_increment_ul_payload_type(radio_node, sizeof(RADIO_GPSM_UL_PAYLOAD_PATTERN));
 errors:
     return status;
 }
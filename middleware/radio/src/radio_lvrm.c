@@ -75,6 +75,13 @@ static const RADIO_LVRM_ul_payload_type_t RADIO_LVRM_UL_PAYLOAD_PATTERN[] = {
     RADIO_LVRM_UL_PAYLOAD_TYPE_MONITORING
 };
 
+static const RADIO_COMMON_data_type_t RADIO_LVRM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE[] = {
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_CURRENT,
+    RADIO_COMMON_DATA_TYPE_STATE
+};
+
 /*** LVRM functions ***/
 
 /*******************************************************************/
@@ -86,6 +93,9 @@ RADIO_status_t RADIO_LVRM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     uint32_t lvrm_registers[LVRM_REGISTER_ADDRESS_LAST];
     RADIO_LVRM_ul_payload_monitoring_t ul_payload_monitoring;
     RADIO_LVRM_ul_payload_electrical_t ul_payload_electrical;
+    uint32_t deadband_field[RADIO_UL_DEADBAND_FIELD_COUNT_MAX];
+    uint8_t send_required = 1;
+    uint8_t payload_type = 0;
     uint8_t idx = 0;
     // Check parameters.
     if ((radio_node == NULL) || (node_payload == NULL)) {
@@ -108,7 +118,9 @@ RADIO_status_t RADIO_LVRM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     // Directly exits if a common payload was computed.
     if ((node_payload->payload_size) > 0) goto errors;
     // Else use specific pattern of the node.
-    switch (RADIO_LVRM_UL_PAYLOAD_PATTERN[radio_node->payload_type_counter]) {
+    status = RADIO_COMMON_get_ul_payload_type(radio_node, (const uint8_t*) RADIO_LVRM_UL_PAYLOAD_PATTERN, sizeof(RADIO_LVRM_UL_PAYLOAD_PATTERN), RADIO_LVRM_UL_PAYLOAD_TYPE_LAST, &payload_type);
+    if (status != RADIO_SUCCESS) goto errors;
+    switch (payload_type) {
     case RADIO_LVRM_UL_PAYLOAD_TYPE_MONITORING:
         // Perform measurements.
         node_status = NODE_perform_measurements((radio_node->node), &access_status);
@@ -116,7 +128,7 @@ RADIO_status_t RADIO_LVRM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_LVRM_REGISTERS_MONITORING, sizeof(RADIO_LVRM_REGISTERS_MONITORING), (uint32_t*) lvrm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_LVRM_REGISTERS_MONITORING, sizeof(RADIO_LVRM_REGISTERS_MONITORING), (uint32_t*) lvrm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
         // Build monitoring payload.
@@ -135,7 +147,7 @@ RADIO_status_t RADIO_LVRM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_LVRM_REGISTERS_ELECTRICAL, sizeof(RADIO_LVRM_REGISTERS_ELECTRICAL), (uint32_t*) lvrm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_LVRM_REGISTERS_ELECTRICAL, sizeof(RADIO_LVRM_REGISTERS_ELECTRICAL), (uint32_t*) lvrm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
         // Build data payload.
@@ -144,6 +156,14 @@ RADIO_status_t RADIO_LVRM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         ul_payload_electrical.output_current = SWREG_read_field(lvrm_registers[LVRM_REGISTER_ADDRESS_ANALOG_DATA_2], LVRM_REGISTER_ANALOG_DATA_2_MASK_OUTPUT_CURRENT);
         ul_payload_electrical.unused = 0;
         ul_payload_electrical.relay_control_state = SWREG_read_field(lvrm_registers[LVRM_REGISTER_ADDRESS_STATUS_1], LVRM_REGISTER_STATUS_1_MASK_RCS);
+        // Skip payload if data did not change significantly.
+        deadband_field[0] = ul_payload_electrical.input_voltage;
+        deadband_field[1] = ul_payload_electrical.output_voltage;
+        deadband_field[2] = ul_payload_electrical.output_current;
+        deadband_field[3] = ul_payload_electrical.relay_control_state;
+        status = RADIO_COMMON_check_deadband(radio_node, payload_type, RADIO_LVRM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE, (uint32_t*) deadband_field, sizeof(RADIO_LVRM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE), &send_required);
+        if (status != RADIO_SUCCESS) goto errors;
+        if (send_required == 0) break;
         // Copy payload.
         for (idx = 0; idx < RADIO_LVRM_UL_PAYLOAD_ELECTRICAL_SIZE; idx++) {
             (node_payload->payload)[idx] = ul_payload_electrical.frame[idx];
@@ -155,7 +175,7 @@ RADIO_status_t RADIO_LVRM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         goto errors;
     }
     // Increment payload type counter.
-    radio_node->payload_type_counter = (((radio_node->payload_type_counter) + 1) % sizeof(RADIO_LVRM_UL_PAYLOAD_PATTERN));
+    RADIO_COMMON_increment_ul_payload_type(radio_node, sizeof(RADIO_LVRM_UL_PAYLOAD_PATTERN));
 errors:
     return status;
 }
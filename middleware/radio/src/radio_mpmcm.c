@@ -161,7 +161,7 @@ static RADIO_status_t _RADIO_MPMCM_build_ul_node_payload_status(UNA_node_t* mpmc
     RADIO_MPMCM_ul_payload_status_t ul_payload_status;
     uint8_t idx = 0;
     // Read related registers.
-    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) RADIO_MPMCM_REGISTERS_STATUS, sizeof(RADIO_MPMCM_REGISTERS_STATUS), (uint32_t*) (radio_mpmcm_ctx.registers), &access_status);
+    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) RADIO_MPMCM_REGISTERS_STATUS, sizeof(RADIO_MPMCM_REGISTERS_STATUS), (uint32_t*) (radio_mpmcm_ctx.registers), NULL, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     if (access_status.flags != 0) goto errors;
     // Build status frame.
@@ -184,7 +184,7 @@ static RADIO_status_t _RADIO_MPMCM_build_ul_node_payload_frequency(UNA_node_t* m
     RADIO_MPMCM_ul_payload_mains_frequency_t ul_payload_mains_frequency;
     uint8_t idx = 0;
     // Read related registers.
-    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) RADIO_MPMCM_REGISTERS_MAINS_FREQUENCY, sizeof(RADIO_MPMCM_REGISTERS_MAINS_FREQUENCY), (uint32_t*) (radio_mpmcm_ctx.registers), &access_status);
+    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) RADIO_MPMCM_REGISTERS_MAINS_FREQUENCY, sizeof(RADIO_MPMCM_REGISTERS_MAINS_FREQUENCY), (uint32_t*) (radio_mpmcm_ctx.registers), NULL, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     if (access_status.flags != 0) goto errors;
     // Build mains frequency frame.
@@ -215,7 +215,7 @@ static RADIO_status_t _RADIO_MPMCM_build_ul_node_payload_voltage(UNA_node_t* mpm
         reg_addr_list[idx] = RADIO_MPMCM_REGISTERS_MAINS_VOLTAGE[idx] + reg_offset;
     }
     // Read related registers.
-    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), &access_status);
+    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), NULL, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     if (access_status.flags != 0) goto errors;
     // Build mains voltage frame.
@@ -248,7 +248,7 @@ static RADIO_status_t _RADIO_MPMCM_build_ul_node_payload_power(UNA_node_t* mpmcm
         reg_addr_list[idx] = RADIO_MPMCM_REGISTERS_MAINS_POWER[idx] + reg_offset;
     }
     // Read related registers.
-    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), &access_status);
+    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), NULL, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     if (access_status.flags != 0) goto errors;
     // Build mains power frame.
@@ -282,7 +282,7 @@ static RADIO_status_t _RADIO_MPMCM_build_ul_node_payload_power_factor(UNA_node_t
         reg_addr_list[idx] = RADIO_MPMCM_REGISTERS_MAINS_POWER_FACTOR[idx] + reg_offset;
     }
     // Read related registers.
-    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), &access_status);
+    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), NULL, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     if (access_status.flags != 0) goto errors;
     // Build mains power factor frame.
@@ -315,7 +315,7 @@ static RADIO_status_t _RADIO_MPMCM_build_ul_node_payload_energy(UNA_node_t* mpmc
         reg_addr_list[idx] = RADIO_MPMCM_REGISTERS_MAINS_ENERGY[idx] + reg_offset;
     }
     // Read related registers.
-    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), &access_status);
+    node_status = NODE_read_registers(mpmcm_node, (uint8_t*) reg_addr_list, sizeof(reg_addr_list), (uint32_t*) (radio_mpmcm_ctx.registers), NULL, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     if (access_status.flags != 0) goto errors;
     // Build mains energy frame.
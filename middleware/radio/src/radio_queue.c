@@ -0,0 +1,311 @@
+/*
+ * radio_queue.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "radio_queue.h"
+
+#include "error.h"
+#include "nvm.h"
+#include "nvm_address.h"
+#include "radio.h"
+#include "types.h"
+#include "uhfm_registers.h"
+
+/*** RADIO QUEUE local macros ***/
+
+#define RADIO_QUEUE_SIZE                        16
+#define RADIO_QUEUE_INDEX_NONE                  0xFF
+
+#define RADIO_QUEUE_HEADER_MARKER               0xA0
+#define RADIO_QUEUE_HEADER_MARKER_MASK          0xF0
+#define RADIO_QUEUE_HEADER_PRIORITY_MASK        0x0F
+#define RADIO_QUEUE_HEADER_INVALID              0x00
+
+// NVM entry format: header, payload size, sequence (2 bytes), payload.
+#define RADIO_QUEUE_NVM_ENTRY_PAYLOAD_OFFSET    4
+#define RADIO_QUEUE_NVM_ENTRY_SIZE_BYTES        (RADIO_QUEUE_NVM_ENTRY_PAYLOAD_OFFSET + UHFM_UL_PAYLOAD_MAX_SIZE_BYTES)
+
+#define RADIO_QUEUE_NVM_BATCH_SIZE              4
+#define RADIO_QUEUE_NVM_FLUSH_PERIOD_SECONDS    3600
+
+/*** RADIO QUEUE local structures ***/
+
+/*******************************************************************/
+typedef union {
+    uint8_t bytes[RADIO_QUEUE_NVM_ENTRY_SIZE_BYTES];
+    struct {
+        uint8_t header;
+        uint8_t ul_payload_size;
+        uint16_t sequence;
+        uint8_t ul_payload[UHFM_UL_PAYLOAD_MAX_SIZE_BYTES];
+    } __attribute__((packed));
+} RADIO_QUEUE_entry_t;
+
+/*******************************************************************/
+typedef struct {
+    RADIO_QUEUE_entry_t entry[RADIO_QUEUE_SIZE];
+    uint16_t dirty_mask;
+    uint16_t sequence;
+    uint8_t peek_index;
+    uint32_t flush_time_seconds;
+} RADIO_QUEUE_context_t;
+
+/*** RADIO QUEUE local global variables ***/
+
+static RADIO_QUEUE_context_t radio_queue_ctx;
+
+/*** RADIO QUEUE local functions ***/
+
+/*******************************************************************/
+static uint8_t _RADIO_QUEUE_is_valid(uint8_t entry_idx) {
+    // Check header marker.
+    return (((radio_queue_ctx.entry[entry_idx].header & RADIO_QUEUE_HEADER_MARKER_MASK) == RADIO_QUEUE_HEADER_MARKER) ? 1 : 0);
+}
+
+/*******************************************************************/
+static uint8_t _RADIO_QUEUE_get_priority(uint8_t entry_idx) {
+    // Read header field.
+    return (radio_queue_ctx.entry[entry_idx].header & RADIO_QUEUE_HEADER_PRIORITY_MASK);
+}
+
+/*******************************************************************/
+static uint8_t _RADIO_QUEUE_is_older(uint8_t entry_idx, uint8_t reference_idx) {
+    // Sequence comparison is robust to counter roll-over.
+    return (((int16_t) (radio_queue_ctx.entry[entry_idx].sequence - radio_queue_ctx.entry[reference_idx].sequence)) < 0) ? 1 : 0;
+}
+
+/*******************************************************************/
+static void _RADIO_QUEUE_invalidate(uint8_t entry_idx) {
+    // Update header and mark entry for next NVM write.
+    radio_queue_ctx.entry[entry_idx].header = RADIO_QUEUE_HEADER_INVALID;
+    radio_queue_ctx.dirty_mask |= (0b1 << entry_idx);
+}
+
+/*******************************************************************/
+static uint8_t _RADIO_QUEUE_get_dirty_count(void) {
+    // Local variables.
+    uint8_t dirty_count = 0;
+    uint8_t idx = 0;
+    // Count bits.
+    for (idx = 0; idx < RADIO_QUEUE_SIZE; idx++) {
+        if ((radio_queue_ctx.dirty_mask & (0b1 << idx)) != 0) {
+            dirty_count++;
+        }
+    }
+    return dirty_count;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_QUEUE_store_entry(uint8_t entry_idx) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint16_t nvm_address = (NVM_ADDRESS_RADIO_QUEUE + (entry_idx * RADIO_QUEUE_NVM_ENTRY_SIZE_BYTES));
+    uint8_t nvm_byte = 0;
+    uint8_t size = RADIO_QUEUE_NVM_ENTRY_SIZE_BYTES;
+    uint8_t idx = 0;
+    // Only the header is relevant for a removed entry.
+    if (_RADIO_QUEUE_is_valid(entry_idx) == 0) {
+        size = 1;
+    }
+    // Byte loop.
+    for (idx = 0; idx < size; idx++) {
+        // Write only the bytes which changed.
+        nvm_status = NVM_read_byte((nvm_address + idx), &nvm_byte);
+        NVM_exit_error(RADIO_ERROR_BASE_NVM);
+        if (nvm_byte == radio_queue_ctx.entry[entry_idx].bytes[idx]) continue;
+        nvm_status = NVM_write_byte((nvm_address + idx), radio_queue_ctx.entry[entry_idx].bytes[idx]);
+        NVM_exit_error(RADIO_ERROR_BASE_NVM);
+    }
+    radio_queue_ctx.dirty_mask &= ~(0b1 << entry_idx);
+errors:
+    return status;
+}
+
+/*** RADIO QUEUE functions ***/
+
+/*******************************************************************/
+RADIO_status_t RADIO_QUEUE_init(void) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint16_t nvm_address = NVM_ADDRESS_RADIO_QUEUE;
+    uint8_t newest_idx = RADIO_QUEUE_INDEX_NONE;
+    uint8_t entry_idx = 0;
+    uint8_t idx = 0;
+    // Init context.
+    radio_queue_ctx.dirty_mask = 0;
+    radio_queue_ctx.sequence = 0;
+    radio_queue_ctx.peek_index = RADIO_QUEUE_INDEX_NONE;
+    radio_queue_ctx.flush_time_seconds = 0;
+    // Load entries.
+    for (entry_idx = 0; entry_idx < RADIO_QUEUE_SIZE; entry_idx++) {
+        for (idx = 0; idx < RADIO_QUEUE_NVM_ENTRY_SIZE_BYTES; idx++) {
+            nvm_status = NVM_read_byte(nvm_address, &(radio_queue_ctx.entry[entry_idx].bytes[idx]));
+            NVM_exit_error(RADIO_ERROR_BASE_NVM);
+            nvm_address++;
+        }
+        // Discard corrupted entries.
+        if ((_RADIO_QUEUE_is_valid(entry_idx) != 0) && ((_RADIO_QUEUE_get_priority(entry_idx) >= RADIO_QUEUE_PRIORITY_LAST) || (radio_queue_ctx.entry[entry_idx].ul_payload_size == 0) || (radio_queue_ctx.entry[entry_idx].ul_payload_size > UHFM_UL_PAYLOAD_MAX_SIZE_BYTES))) {
+            _RADIO_QUEUE_invalidate(entry_idx);
+        }
+        if (_RADIO_QUEUE_is_valid(entry_idx) == 0) continue;
+        // Resume sequence after the newest entry.
+        if ((newest_idx == RADIO_QUEUE_INDEX_NONE) || (_RADIO_QUEUE_is_older(newest_idx, entry_idx) != 0)) {
+            newest_idx = entry_idx;
+        }
+    }
+    if (newest_idx != RADIO_QUEUE_INDEX_NONE) {
+        radio_queue_ctx.sequence = (radio_queue_ctx.entry[newest_idx].sequence + 1);
+    }
+errors:
+    // Start with an empty queue if NVM can not be read.
+    if (status != RADIO_SUCCESS) {
+        for (entry_idx = 0; entry_idx < RADIO_QUEUE_SIZE; entry_idx++) {
+            radio_queue_ctx.entry[entry_idx].header = RADIO_QUEUE_HEADER_INVALID;
+        }
+    }
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_QUEUE_push(RADIO_QUEUE_frame_t* frame) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t entry_idx = RADIO_QUEUE_INDEX_NONE;
+    uint8_t idx = 0;
+    // Check parameters.
+    if (frame == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((frame->ul_payload) == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (((frame->ul_payload_size) == 0) || ((frame->ul_payload_size) > UHFM_UL_PAYLOAD_MAX_SIZE_BYTES)) {
+        status = RADIO_ERROR_MODEM_UL_PAYLOAD;
+        goto errors;
+    }
+    if ((frame->priority) >= RADIO_QUEUE_PRIORITY_LAST) {
+        status = RADIO_ERROR_UL_QUEUE_PRIORITY;
+        goto errors;
+    }
+    // Search free entry.
+    for (idx = 0; idx < RADIO_QUEUE_SIZE; idx++) {
+        if (_RADIO_QUEUE_is_valid(idx) == 0) {
+            entry_idx = idx;
+            break;
+        }
+    }
+    // Else evict the oldest entry of lowest priority.
+    if (entry_idx == RADIO_QUEUE_INDEX_NONE) {
+        for (idx = 0; idx < RADIO_QUEUE_SIZE; idx++) {
+            if ((entry_idx == RADIO_QUEUE_INDEX_NONE) || (_RADIO_QUEUE_get_priority(idx) < _RADIO_QUEUE_get_priority(entry_idx))) {
+                entry_idx = idx;
+                continue;
+            }
+            if ((_RADIO_QUEUE_get_priority(idx) == _RADIO_QUEUE_get_priority(entry_idx)) && (_RADIO_QUEUE_is_older(idx, entry_idx) != 0)) {
+                entry_idx = idx;
+            }
+        }
+        // Drop the new frame if all stored frames are more important.
+        if (_RADIO_QUEUE_get_priority(entry_idx) > (frame->priority)) {
+            status = RADIO_ERROR_UL_QUEUE_FULL;
+            goto errors;
+        }
+    }
+    // Fill entry.
+    radio_queue_ctx.entry[entry_idx].header = (RADIO_QUEUE_HEADER_MARKER | (frame->priority));
+    radio_queue_ctx.entry[entry_idx].ul_payload_size = (frame->ul_payload_size);
+    radio_queue_ctx.entry[entry_idx].sequence = radio_queue_ctx.sequence;
+    for (idx = 0; idx < UHFM_UL_PAYLOAD_MAX_SIZE_BYTES; idx++) {
+        radio_queue_ctx.entry[entry_idx].ul_payload[idx] = (idx < (frame->ul_payload_size)) ? (frame->ul_payload)[idx] : 0x00;
+    }
+    radio_queue_ctx.dirty_mask |= (0b1 << entry_idx);
+    radio_queue_ctx.sequence++;
+    radio_queue_ctx.peek_index = RADIO_QUEUE_INDEX_NONE;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_QUEUE_peek(RADIO_QUEUE_frame_t* frame) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t entry_idx = RADIO_QUEUE_INDEX_NONE;
+    uint8_t idx = 0;
+    // Check parameters.
+    if (frame == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    frame->ul_payload_size = 0;
+    // Search highest priority, then oldest entry.
+    for (idx = 0; idx < RADIO_QUEUE_SIZE; idx++) {
+        if (_RADIO_QUEUE_is_valid(idx) == 0) continue;
+        if ((entry_idx == RADIO_QUEUE_INDEX_NONE) || (_RADIO_QUEUE_get_priority(idx) > _RADIO_QUEUE_get_priority(entry_idx))) {
+            entry_idx = idx;
+            continue;
+        }
+        if ((_RADIO_QUEUE_get_priority(idx) == _RADIO_QUEUE_get_priority(entry_idx)) && (_RADIO_QUEUE_is_older(idx, entry_idx) != 0)) {
+            entry_idx = idx;
+        }
+    }
+    radio_queue_ctx.peek_index = entry_idx;
+    if (entry_idx == RADIO_QUEUE_INDEX_NONE) goto errors;
+    // Update frame.
+    frame->ul_payload = (uint8_t*) radio_queue_ctx.entry[entry_idx].ul_payload;
+    frame->ul_payload_size = radio_queue_ctx.entry[entry_idx].ul_payload_size;
+    frame->priority = _RADIO_QUEUE_get_priority(entry_idx);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void RADIO_QUEUE_pop(void) {
+    // Check index.
+    if (radio_queue_ctx.peek_index >= RADIO_QUEUE_SIZE) goto errors;
+    _RADIO_QUEUE_invalidate(radio_queue_ctx.peek_index);
+    radio_queue_ctx.peek_index = RADIO_QUEUE_INDEX_NONE;
+errors:
+    return;
+}
+
+/*******************************************************************/
+uint8_t RADIO_QUEUE_get_count(void) {
+    // Local variables.
+    uint8_t count = 0;
+    uint8_t idx = 0;
+    // Count valid entries.
+    for (idx = 0; idx < RADIO_QUEUE_SIZE; idx++) {
+        count += _RADIO_QUEUE_is_valid(idx);
+    }
+    return count;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_QUEUE_flush(uint32_t uptime_seconds, uint8_t force_flag) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    uint8_t idx = 0;
+    // Check if there is something to write.
+    if (radio_queue_ctx.dirty_mask == 0) {
+        radio_queue_ctx.flush_time_seconds = uptime_seconds;
+        goto errors;
+    }
+    // Batch writes unless forced.
+    if ((force_flag == 0) && (_RADIO_QUEUE_get_dirty_count() < RADIO_QUEUE_NVM_BATCH_SIZE) && (uptime_seconds < (radio_queue_ctx.flush_time_seconds + RADIO_QUEUE_NVM_FLUSH_PERIOD_SECONDS))) goto errors;
+    // Write modified entries.
+    for (idx = 0; idx < RADIO_QUEUE_SIZE; idx++) {
+        if ((radio_queue_ctx.dirty_mask & (0b1 << idx)) == 0) continue;
+        status = _RADIO_QUEUE_store_entry(idx);
+        if (status != RADIO_SUCCESS) goto errors;
+    }
+    radio_queue_ctx.flush_time_seconds = uptime_seconds;
+errors:
+    return status;
+}
@@ -68,7 +68,7 @@ RADIO_status_t RADIO_R4S8CR_build_ul_node_payload(RADIO_node_t* radio_node, RADI
     // Reset payload size.
     node_payload->payload_size = 0;
     // Read related registers.
-    node_status = NODE_read_registers((radio_node->node), (uint8_t*) R4S8CR_REGISTER_LIST_UL_PAYLOAD_ELECTRICAL, sizeof(R4S8CR_REGISTER_LIST_UL_PAYLOAD_ELECTRICAL), (uint32_t*) r4s8cr_registers, &access_status);
+    node_status = NODE_read_registers((radio_node->node), (uint8_t*) R4S8CR_REGISTER_LIST_UL_PAYLOAD_ELECTRICAL, sizeof(R4S8CR_REGISTER_LIST_UL_PAYLOAD_ELECTRICAL), (uint32_t*) r4s8cr_registers, NULL, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     // Build data payload.
     ul_payload_data.relay1_status = SWREG_read_field(r4s8cr_registers[R4S8CR_REGISTER_ADDRESS_STATUS], R4S8CR_REGISTER_STATUS_MASK_R1ST);
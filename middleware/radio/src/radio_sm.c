@@ -95,6 +95,22 @@ static const RADIO_SM_ul_payload_type_t RADIO_SM_UL_PAYLOAD_PATTERN[] = {
     RADIO_SM_UL_PAYLOAD_TYPE_MONITORING
 };
 
+static const RADIO_COMMON_data_type_t RADIO_SM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE[] = {
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_VOLTAGE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE,
+    RADIO_COMMON_DATA_TYPE_STATE
+};
+
+static const RADIO_COMMON_data_type_t RADIO_SM_UL_PAYLOAD_SENSOR_DATA_TYPE[] = {
+    RADIO_COMMON_DATA_TYPE_TEMPERATURE,
+    RADIO_COMMON_DATA_TYPE_STATE
+};
+
 /*** RADIO SM functions ***/
 
 /*******************************************************************/
@@ -108,6 +124,9 @@ RADIO_status_t RADIO_SM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul
     RADIO_SM_ul_payload_electrical_t ul_payload_electrical;
     RADIO_SM_ul_payload_sensor_t ul_payload_sensor;
     uint32_t reg_configuration = 0;
+    uint32_t deadband_field[RADIO_UL_DEADBAND_FIELD_COUNT_MAX];
+    uint8_t send_required = 1;
+    uint8_t payload_type = 0;
     uint8_t idx = 0;
     uint32_t loop_count = 0;
     // Check parameters.
@@ -138,7 +157,9 @@ RADIO_status_t RADIO_SM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul
     reg_configuration = sm_registers[SM_REGISTER_ADDRESS_FLAGS_1];
     // Payloads loop.
     do {
-        switch (RADIO_SM_UL_PAYLOAD_PATTERN[radio_node->payload_type_counter]) {
+        status = RADIO_COMMON_get_ul_payload_type(radio_node, (const uint8_t*) RADIO_SM_UL_PAYLOAD_PATTERN, sizeof(RADIO_SM_UL_PAYLOAD_PATTERN), RADIO_SM_UL_PAYLOAD_TYPE_LAST, &payload_type);
+        if (status != RADIO_SUCCESS) goto errors;
+        switch (payload_type) {
         case RADIO_SM_UL_PAYLOAD_TYPE_MONITORING:
             // Perform measurements.
             node_status = NODE_perform_measurements((radio_node->node), &access_status);
@@ -146,7 +167,7 @@ RADIO_status_t RADIO_SM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul
             // Check write status.
             if (access_status.flags == 0) {
                 // Read related registers.
-                node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_SM_REGISTERS_MONITORING, sizeof(RADIO_SM_REGISTERS_MONITORING), (uint32_t*) sm_registers, &access_status);
+                node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_SM_REGISTERS_MONITORING, sizeof(RADIO_SM_REGISTERS_MONITORING), (uint32_t*) sm_registers, NULL, &access_status);
                 NODE_exit_error(RADIO_ERROR_BASE_NODE);
             }
             // Build data payload.
@@ -167,7 +188,7 @@ RADIO_status_t RADIO_SM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul
             // Check write status.
             if (access_status.flags == 0) {
                 // Read related registers.
-                node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_SM_REGISTERS_ELECTRICAL, sizeof(RADIO_SM_REGISTERS_ELECTRICAL), (uint32_t*) sm_registers, &access_status);
+                node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_SM_REGISTERS_ELECTRICAL, sizeof(RADIO_SM_REGISTERS_ELECTRICAL), (uint32_t*) sm_registers, NULL, &access_status);
                 NODE_exit_error(RADIO_ERROR_BASE_NODE);
             }
             // Build data payload.
@@ -179,6 +200,18 @@ RADIO_status_t RADIO_SM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul
             ul_payload_electrical.dio1 = SWREG_read_field(sm_registers[SM_REGISTER_ADDRESS_DIGITAL_DATA], SM_REGISTER_DIGITAL_DATA_MASK_DIO1);
             ul_payload_electrical.dio2 = SWREG_read_field(sm_registers[SM_REGISTER_ADDRESS_DIGITAL_DATA], SM_REGISTER_DIGITAL_DATA_MASK_DIO2);
             ul_payload_electrical.dio3 = SWREG_read_field(sm_registers[SM_REGISTER_ADDRESS_DIGITAL_DATA], SM_REGISTER_DIGITAL_DATA_MASK_DIO3);
+            // Skip payload if data did not change significantly.
+            deadband_field[0] = ul_payload_electrical.ain0;
+            deadband_field[1] = ul_payload_electrical.ain1;
+            deadband_field[2] = ul_payload_electrical.ain2;
+            deadband_field[3] = ul_payload_electrical.ain3;
+            deadband_field[4] = ul_payload_electrical.dio0;
+            deadband_field[5] = ul_payload_electrical.dio1;
+            deadband_field[6] = ul_payload_electrical.dio2;
+            deadband_field[7] = ul_payload_electrical.dio3;
+            status = RADIO_COMMON_check_deadband(radio_node, payload_type, RADIO_SM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE, (uint32_t*) deadband_field, sizeof(RADIO_SM_UL_PAYLOAD_ELECTRICAL_DATA_TYPE), &send_required);
+            if (status != RADIO_SUCCESS) goto errors;
+            if (send_required == 0) break;
             // Copy payload.
             for (idx = 0; idx < RADIO_SM_UL_PAYLOAD_ELECTRICAL_SIZE; idx++) {
                 (node_payload->payload)[idx] = ul_payload_electrical.frame[idx];
@@ -194,12 +227,18 @@ RADIO_status_t RADIO_SM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul
             // Check write status.
             if (access_status.flags == 0) {
                 // Read related registers.
-                node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_SM_REGISTERS_SENSOR, sizeof(RADIO_SM_REGISTERS_SENSOR), (uint32_t*) sm_registers, &access_status);
+                node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_SM_REGISTERS_SENSOR, sizeof(RADIO_SM_REGISTERS_SENSOR), (uint32_t*) sm_registers, NULL, &access_status);
                 NODE_exit_error(RADIO_ERROR_BASE_NODE);
             }
             // Build data payload.
             ul_payload_sensor.temperature = SWREG_read_field(sm_registers[SM_REGISTER_ADDRESS_ANALOG_DATA_3], SM_REGISTER_ANALOG_DATA_3_MASK_TEMPERATURE);
             ul_payload_sensor.humidity = SWREG_read_field(sm_registers[SM_REGISTER_ADDRESS_ANALOG_DATA_3], SM_REGISTER_ANALOG_DATA_3_MASK_HUMIDITY);
+            // Skip payload if data did not change significantly.
+            deadband_field[0] = ul_payload_sensor.temperature;
+            deadband_field[1] = ul_payload_sensor.humidity;
+            status = RADIO_COMMON_check_deadband(radio_node, payload_type, RADIO_SM_UL_PAYLOAD_SENSOR_DATA_TYPE, (uint32_t*) deadband_field, sizeof(RADIO_SM_UL_PAYLOAD_SENSOR_DATA_TYPE), &send_required);
+            if (status != RADIO_SUCCESS) goto errors;
+            if (send_required == 0) break;
             // Copy payload.
             for (idx = 0; idx < RADIO_SM_UL_PAYLOAD_SENSOR_SIZE; idx++) {
                 (node_payload->payload)[idx] = ul_payload_sensor.frame[idx];
@@ -211,12 +250,12 @@ RADIO_status_t RADIO_SM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_ul
             goto errors;
         }
         // Increment payload type counter.
-        radio_node->payload_type_counter = (((radio_node->payload_type_counter) + 1) % sizeof(RADIO_SM_UL_PAYLOAD_PATTERN));
+        RADIO_COMMON_increment_ul_payload_type(radio_node, sizeof(RADIO_SM_UL_PAYLOAD_PATTERN));
         // Exit in case of loop error.
         loop_count++;
         if (loop_count > RADIO_SM_UL_PAYLOAD_LOOP_MAX) goto errors;
     }
-    while ((node_payload->payload_size) == 0);
+    while (((node_payload->payload_size) == 0) && (send_required != 0));
 errors:
     return status;
 }
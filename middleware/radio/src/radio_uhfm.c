@@ -8,15 +8,41 @@
 #include "radio_uhfm.h"
 
 #include "common_registers.h"
+#include "dmm_flags.h"
+#include "error.h"
+#include "error_base.h"
+#include "iwdg.h"
+#include "lptim.h"
+#include "node.h"
 #include "radio.h"
+#include "radio_codec.h"
 #include "radio_common.h"
+#include "rtc.h"
 #include "swreg.h"
 #include "uhfm_registers.h"
 #include "una.h"
 
 /*** UHFM local macros ***/
 
-#define RADIO_UHFM_UL_PAYLOAD_MONITORING_SIZE   9
+#define RADIO_UHFM_UL_PAYLOAD_MONITORING_SIZE                   9
+#define RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SIZE           7
+#define RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SIZE_NO_RADIO  4
+
+#define RADIO_UHFM_COMPACT_VOLTAGE_LSB_MV                       1
+#define RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS                    12
+#define RADIO_UHFM_COMPACT_TEMPERATURE_LSB_TENTH_DEGREES        1
+#define RADIO_UHFM_COMPACT_TEMPERATURE_SIZE_BITS                12
+
+// Uplink sequence: payload registers and optional settings, followed by the trigger.
+#define RADIO_UHFM_UL_PAYLOAD_REGISTER_COUNT                    ((UHFM_UL_PAYLOAD_MAX_SIZE_BYTES + 3) / 4)
+#define RADIO_UHFM_UL_REGISTER_LIST_SIZE                        (RADIO_UHFM_UL_PAYLOAD_REGISTER_COUNT + 1)
+
+// The modem does not reply while transmitting: the message status is polled once the minimum sequence duration is elapsed.
+#define RADIO_UHFM_UL_DURATION_MIN_SECONDS                      2
+#define RADIO_UHFM_UL_DURATION_MAX_SECONDS                      15
+#define RADIO_UHFM_DL_DURATION_MIN_SECONDS                      40
+#define RADIO_UHFM_DL_DURATION_MAX_SECONDS                      75
+#define RADIO_UHFM_POLL_PERIOD_MS                               1000
 
 /*** UHFM local structures ***/
 
@@ -38,6 +64,36 @@ typedef union {
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } RADIO_UHFM_ul_payload_monitoring_t;
 
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+/*******************************************************************/
+typedef enum {
+    RADIO_UHFM_COMPACT_FIELD_HEADER = 0,
+    RADIO_UHFM_COMPACT_FIELD_MCU_VOLTAGE,
+    RADIO_UHFM_COMPACT_FIELD_MCU_TEMPERATURE,
+    RADIO_UHFM_COMPACT_FIELD_RADIO_TX_VOLTAGE,
+    RADIO_UHFM_COMPACT_FIELD_RADIO_RX_VOLTAGE,
+    RADIO_UHFM_COMPACT_FIELD_LAST
+} RADIO_UHFM_compact_field_t;
+#endif
+
+/*******************************************************************/
+typedef enum {
+    RADIO_UHFM_STATE_IDLE = 0,
+    RADIO_UHFM_STATE_TRANSMITTING,
+    RADIO_UHFM_STATE_LAST
+} RADIO_UHFM_state_t;
+
+/*******************************************************************/
+typedef struct {
+    UNA_node_address_t node_addr;
+    uint8_t config_0_restore_pending;
+    uint32_t config_0_nominal;
+    uint32_t config_0_mask;
+    RADIO_UHFM_state_t state;
+    uint32_t poll_time_seconds;
+    uint32_t timeout_time_seconds;
+} RADIO_UHFM_context_t;
+
 /*** UHFM global variables ***/
 
 static const uint8_t RADIO_UHFM_REGISTERS_MONITORING[] = {
@@ -49,6 +105,89 @@ static const RADIO_UHFM_ul_payload_type_t RADIO_UHFM_UL_PAYLOAD_PATTERN[] = {
     RADIO_UHFM_UL_PAYLOAD_TYPE_MONITORING
 };
 
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+static const RADIO_CODEC_field_t RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_FIELDS[] = {
+    { RADIO_UHFM_COMPACT_FIELD_HEADER, 0, 8 },
+    { RADIO_UHFM_COMPACT_FIELD_MCU_VOLTAGE, 8, RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS },
+    { RADIO_UHFM_COMPACT_FIELD_MCU_TEMPERATURE, 20, RADIO_UHFM_COMPACT_TEMPERATURE_SIZE_BITS },
+    { RADIO_UHFM_COMPACT_FIELD_RADIO_TX_VOLTAGE, 32, RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS },
+    { RADIO_UHFM_COMPACT_FIELD_RADIO_RX_VOLTAGE, 44, RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS }
+};
+
+static const RADIO_CODEC_schema_t RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SCHEMA = RADIO_CODEC_SCHEMA(RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_FIELDS, RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SIZE);
+#endif
+
+static RADIO_UHFM_context_t radio_uhfm_ctx = {
+    .node_addr = UNA_NODE_ADDRESS_ERROR,
+    .config_0_restore_pending = 0,
+    .config_0_nominal = 0,
+    .config_0_mask = 0,
+    .state = RADIO_UHFM_STATE_IDLE,
+    .poll_time_seconds = 0,
+    .timeout_time_seconds = 0
+};
+
+/*** UHFM local functions ***/
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_UHFM_update_state(UNA_node_t* uhfm_node) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_status_t radio_status = RADIO_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    UNA_access_status_t access_status;
+    UHFM_ul_message_status_t message_status;
+    uint32_t reg_status_1 = 0;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    // Check state.
+    if (radio_uhfm_ctx.state != RADIO_UHFM_STATE_TRANSMITTING) goto errors;
+    if (uptime_seconds < radio_uhfm_ctx.poll_time_seconds) goto errors;
+    // Release modem if it does not reply anymore.
+    if (uptime_seconds >= radio_uhfm_ctx.timeout_time_seconds) {
+        radio_uhfm_ctx.state = RADIO_UHFM_STATE_IDLE;
+        status = RADIO_ERROR_MODEM_UL_COMPLETION;
+        goto errors;
+    }
+    // Read message status (the deferred reply of the trigger is flushed before the request and a failed read means the modem is still busy).
+    node_status = NODE_poll_register(uhfm_node, UHFM_REGISTER_ADDRESS_STATUS_1, &reg_status_1, &access_status);
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    if ((access_status.flags) != 0) goto errors;
+    // Transmission is completed when the message status reports the first frame or an error.
+    message_status.all = SWREG_read_field(reg_status_1, UHFM_REGISTER_STATUS_1_MASK_SIGFOX_MESSAGE_STATUS);
+    if ((message_status.field.execution_error != 0) || (message_status.field.network_error != 0)) {
+        radio_uhfm_ctx.state = RADIO_UHFM_STATE_IDLE;
+        // Error is only stored since it does not prevent the next modem access.
+        radio_status = RADIO_ERROR_MODEM_UL_TRANSMISSION;
+        RADIO_stack_error(ERROR_BASE_RADIO);
+    }
+    else if (message_status.field.ul_frame_1 != 0) {
+        radio_uhfm_ctx.state = RADIO_UHFM_STATE_IDLE;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static RADIO_status_t _RADIO_UHFM_restore_configuration(UNA_node_t* uhfm_node) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    NODE_status_t node_status = NODE_SUCCESS;
+    UNA_access_status_t access_status;
+    // Check if nominal settings have to be restored on this modem.
+    if ((radio_uhfm_ctx.config_0_restore_pending == 0) || (radio_uhfm_ctx.node_addr != (uhfm_node->address))) goto errors;
+    // Write nominal settings.
+    node_status = NODE_write_register(uhfm_node, UHFM_REGISTER_ADDRESS_CONFIGURATION_0, radio_uhfm_ctx.config_0_nominal, radio_uhfm_ctx.config_0_mask, &access_status);
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    // Check access status (restore is retried on next modem access otherwise).
+    if ((access_status.flags) != 0) {
+        status = RADIO_ERROR_MODEL_UL_CONFIGURATION;
+        goto errors;
+    }
+    radio_uhfm_ctx.config_0_restore_pending = 0;
+errors:
+    return status;
+}
+
 /*** UHFM functions ***/
 
 /*******************************************************************/
@@ -58,7 +197,12 @@ RADIO_status_t RADIO_UHFM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     NODE_status_t node_status = NODE_SUCCESS;
     UNA_access_status_t access_status;
     uint32_t uhfm_registers[UHFM_REGISTER_ADDRESS_LAST];
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+    uint32_t ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_LAST];
+#else
     RADIO_UHFM_ul_payload_monitoring_t ul_payload_monitoring;
+#endif
+    uint8_t payload_type = 0;
     uint8_t idx = 0;
     // Check parameters.
     if ((radio_node == NULL) || (node_payload == NULL)) {
@@ -69,6 +213,9 @@ RADIO_status_t RADIO_UHFM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         status = RADIO_ERROR_NULL_PARAMETER;
         goto errors;
     }
+    // Modem registers can not be read while transmitting.
+    status = RADIO_UHFM_wait_completion(radio_node->node);
+    if (status != RADIO_SUCCESS) goto errors;
     // Reset registers.
     for (idx = 0; idx < UHFM_REGISTER_ADDRESS_LAST; idx++) {
         uhfm_registers[idx] = UHFM_REGISTER[idx].error_value;
@@ -81,7 +228,9 @@ RADIO_status_t RADIO_UHFM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
     // Directly exits if a common payload was computed.
     if ((node_payload->payload_size) > 0) goto errors;
     // Else use specific pattern of the node.
-    switch (RADIO_UHFM_UL_PAYLOAD_PATTERN[radio_node->payload_type_counter]) {
+    status = RADIO_COMMON_get_ul_payload_type(radio_node, (const uint8_t*) RADIO_UHFM_UL_PAYLOAD_PATTERN, sizeof(RADIO_UHFM_UL_PAYLOAD_PATTERN), RADIO_UHFM_UL_PAYLOAD_TYPE_LAST, &payload_type);
+    if (status != RADIO_SUCCESS) goto errors;
+    switch (payload_type) {
     case RADIO_UHFM_UL_PAYLOAD_TYPE_MONITORING:
         // Perform measurements.
         node_status = NODE_perform_measurements((radio_node->node), &access_status);
@@ -89,9 +238,24 @@ RADIO_status_t RADIO_UHFM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
         // Check write status.
         if (access_status.flags == 0) {
             // Read related registers.
-            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_UHFM_REGISTERS_MONITORING, sizeof(RADIO_UHFM_REGISTERS_MONITORING), (uint32_t*) uhfm_registers, &access_status);
+            node_status = NODE_read_registers((radio_node->node), (uint8_t*) RADIO_UHFM_REGISTERS_MONITORING, sizeof(RADIO_UHFM_REGISTERS_MONITORING), (uint32_t*) uhfm_registers, NULL, &access_status);
             NODE_exit_error(RADIO_ERROR_BASE_NODE);
         }
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+        // Build compact monitoring payload.
+        ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_HEADER] = RADIO_COMMON_get_compact_header(RADIO_COMMON_COMPACT_ENCODING_ABSOLUTE);
+        ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_MCU_VOLTAGE] = RADIO_COMMON_get_compact_field(RADIO_COMMON_DATA_TYPE_VOLTAGE, SWREG_read_field(uhfm_registers[COMMON_REGISTER_ADDRESS_ANALOG_DATA_0], COMMON_REGISTER_ANALOG_DATA_0_MASK_MCU_VOLTAGE), RADIO_UHFM_COMPACT_VOLTAGE_LSB_MV, RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS);
+        ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_MCU_TEMPERATURE] = RADIO_COMMON_get_compact_field(RADIO_COMMON_DATA_TYPE_TEMPERATURE, SWREG_read_field(uhfm_registers[COMMON_REGISTER_ADDRESS_ANALOG_DATA_0], COMMON_REGISTER_ANALOG_DATA_0_MASK_MCU_TEMPERATURE), RADIO_UHFM_COMPACT_TEMPERATURE_LSB_TENTH_DEGREES, RADIO_UHFM_COMPACT_TEMPERATURE_SIZE_BITS);
+        ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_RADIO_TX_VOLTAGE] = RADIO_COMMON_get_compact_field(RADIO_COMMON_DATA_TYPE_VOLTAGE, SWREG_read_field(uhfm_registers[UHFM_REGISTER_ADDRESS_ANALOG_DATA_1], UHFM_REGISTER_ANALOG_DATA_1_MASK_RADIO_TX_VOLTAGE), RADIO_UHFM_COMPACT_VOLTAGE_LSB_MV, RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS);
+        ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_RADIO_RX_VOLTAGE] = RADIO_COMMON_get_compact_field(RADIO_COMMON_DATA_TYPE_VOLTAGE, SWREG_read_field(uhfm_registers[UHFM_REGISTER_ADDRESS_ANALOG_DATA_1], UHFM_REGISTER_ANALOG_DATA_1_MASK_RADIO_RX_VOLTAGE), RADIO_UHFM_COMPACT_VOLTAGE_LSB_MV, RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS);
+        status = RADIO_CODEC_pack(&RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SCHEMA, (uint32_t*) ul_payload_monitoring_field, (node_payload->payload));
+        if (status != RADIO_SUCCESS) goto errors;
+        // Drop trailing radio voltages if they are unknown.
+        node_payload->payload_size = RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SIZE;
+        if ((ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_RADIO_TX_VOLTAGE] == ((0b1 << RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS) - 1)) && (ul_payload_monitoring_field[RADIO_UHFM_COMPACT_FIELD_RADIO_RX_VOLTAGE] == ((0b1 << RADIO_UHFM_COMPACT_VOLTAGE_SIZE_BITS) - 1))) {
+            node_payload->payload_size = RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SIZE_NO_RADIO;
+        }
+#else
         // Build monitoring payload.
         ul_payload_monitoring.mcu_voltage = SWREG_read_field(uhfm_registers[COMMON_REGISTER_ADDRESS_ANALOG_DATA_0], COMMON_REGISTER_ANALOG_DATA_0_MASK_MCU_VOLTAGE);
         ul_payload_monitoring.mcu_temperature = SWREG_read_field(uhfm_registers[COMMON_REGISTER_ADDRESS_ANALOG_DATA_0], COMMON_REGISTER_ANALOG_DATA_0_MASK_MCU_TEMPERATURE);
@@ -103,104 +267,181 @@ RADIO_status_t RADIO_UHFM_build_ul_node_payload(RADIO_node_t* radio_node, RADIO_
             (node_payload->payload)[idx] = ul_payload_monitoring.frame[idx];
         }
         node_payload->payload_size = RADIO_UHFM_UL_PAYLOAD_MONITORING_SIZE;
+#endif
         break;
     default:
         status = RADIO_ERROR_UL_NODE_PAYLOAD_TYPE;
         goto errors;
     }
     // Increment payload type counter.
-    radio_node->payload_type_counter = (((radio_node->payload_type_counter) + 1) % sizeof(RADIO_UHFM_UL_PAYLOAD_PATTERN));
+    RADIO_COMMON_increment_ul_payload_type(radio_node, sizeof(RADIO_UHFM_UL_PAYLOAD_PATTERN));
 errors:
     return status;
 }
 
+/*******************************************************************/
+RADIO_status_t RADIO_UHFM_check_schemas(void) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+#ifdef DMM_RADIO_UL_PAYLOAD_COMPACT
+    // Check compact payload schema.
+    status = RADIO_CODEC_check_schema(&RADIO_UHFM_UL_PAYLOAD_MONITORING_COMPACT_SCHEMA);
+#endif
+    return status;
+}
+
 /*******************************************************************/
 RADIO_status_t RADIO_UHFM_send_ul_message(UNA_node_t* uhfm_node, UHFM_ul_message_t* ul_message) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_status_t radio_status = RADIO_SUCCESS;
     NODE_status_t node_status = NODE_SUCCESS;
     UNA_access_status_t access_status;
-    uint32_t reg_config_0_initial = 0;
+    uint8_t reg_addr_list[RADIO_UHFM_UL_REGISTER_LIST_SIZE];
+    uint32_t reg_value_list[RADIO_UHFM_UL_REGISTER_LIST_SIZE];
+    uint32_t reg_mask_list[RADIO_UHFM_UL_REGISTER_LIST_SIZE];
     uint32_t reg_config_0 = 0;
     uint32_t reg_config_0_mask = 0;
     uint32_t reg_control_1 = 0;
     uint32_t reg_control_1_mask = 0;
-    uint32_t ul_payload_x = 0;
-    uint8_t reg_offset = 0;
-    uint8_t dump_valid = 0;
+    uint8_t payload_reg_count = 0;
+    uint8_t reg_count = 0;
+    uint8_t write_count = 0;
+    uint8_t session_opened = 0;
     uint8_t idx = 0;
     // Check parameters.
     if ((uhfm_node == NULL) || (ul_message == NULL)) {
         status = RADIO_ERROR_NULL_PARAMETER;
         goto errors;
     }
-    // UL payload.
-    for (idx = 0; idx < (ul_message->ul_payload_size); idx++) {
-        // Build register.
-        ul_payload_x |= (((ul_message->ul_payload)[idx]) << ((idx % 4) << 3));
-        // Check index.
-        if ((((idx + 1) % 4) == 0) || (idx == ((ul_message->ul_payload_size) - 1))) {
-            // Write register.
-            node_status = NODE_write_register(uhfm_node, (UHFM_REGISTER_ADDRESS_SIGFOX_UL_PAYLOAD_0 + reg_offset), ul_payload_x, UNA_REGISTER_MASK_ALL, &access_status);
-            NODE_exit_error(RADIO_ERROR_BASE_NODE);
-            // Check access status.
-            if ((access_status.flags) != 0) {
-                status = RADIO_ERROR_MODEM_UL_PAYLOAD;
-                goto errors;
-            }
-            // Go to next register and reset value.
-            reg_offset++;
-            ul_payload_x = 0;
-        }
+    if (((ul_message->ul_payload) == NULL) || ((ul_message->ul_payload_size) == 0) || ((ul_message->ul_payload_size) > UHFM_UL_PAYLOAD_MAX_SIZE_BYTES)) {
+        status = RADIO_ERROR_MODEM_UL_PAYLOAD;
+        goto errors;
     }
+    // Never push a frame while the previous one is being transmitted.
+    status = RADIO_UHFM_wait_completion(uhfm_node);
+    if (status != RADIO_SUCCESS) goto errors;
+    // Keep the bus interface configured for the whole sequence.
+    node_status = NODE_open_session();
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    session_opened = 1;
+    // Nominal settings must have been restored before reading them again.
+    status = _RADIO_UHFM_restore_configuration(uhfm_node);
+    if (status != RADIO_SUCCESS) goto errors;
+    // Dump radio settings for bidirectional frames only.
     if ((ul_message->bidirectional_flag) != 0) {
-        // Dump radio settings.
-        node_status = NODE_read_register(uhfm_node, UHFM_REGISTER_ADDRESS_CONFIGURATION_0, &reg_config_0_initial, &access_status);
+        node_status = NODE_read_register(uhfm_node, UHFM_REGISTER_ADDRESS_CONFIGURATION_0, &(radio_uhfm_ctx.config_0_nominal), &access_status);
         NODE_exit_error(RADIO_ERROR_BASE_NODE);
         // Check access status.
         if ((access_status.flags) != 0) {
             status = RADIO_ERROR_MODEL_UL_CONFIGURATION;
             goto errors;
         }
-        dump_valid = 1;
-        reg_config_0 = reg_config_0_initial;
-        // Switch to optimal transmission settings.
+    }
+    // UL payload.
+    for (idx = 0; idx < (ul_message->ul_payload_size); idx++) {
+        // Reset register.
+        if ((idx % 4) == 0) {
+            reg_addr_list[payload_reg_count] = (UHFM_REGISTER_ADDRESS_SIGFOX_UL_PAYLOAD_0 + payload_reg_count);
+            reg_value_list[payload_reg_count] = 0;
+            reg_mask_list[payload_reg_count] = UNA_REGISTER_MASK_ALL;
+            payload_reg_count++;
+        }
+        // Build register.
+        reg_value_list[payload_reg_count - 1] |= (((ul_message->ul_payload)[idx]) << ((idx % 4) << 3));
+    }
+    reg_count = payload_reg_count;
+    // Switch to optimal transmission settings for bidirectional frames (nominal settings are restored at the end of the transmission).
+    if ((ul_message->bidirectional_flag) != 0) {
+        reg_config_0 = radio_uhfm_ctx.config_0_nominal;
         SWREG_write_field(&reg_config_0, &reg_config_0_mask, UNA_convert_dbm(14), UHFM_REGISTER_CONFIGURATION_0_MASK_SIGFOX_TX_POWER);
         SWREG_write_field(&reg_config_0, &reg_config_0_mask, 0b0, UHFM_REGISTER_CONFIGURATION_0_MASK_SBR);
         SWREG_write_field(&reg_config_0, &reg_config_0_mask, 0b11, UHFM_REGISTER_CONFIGURATION_0_MASK_SNFR);
-        // Write register.
-        node_status = NODE_write_register(uhfm_node, UHFM_REGISTER_ADDRESS_CONFIGURATION_0, reg_config_0, reg_config_0_mask, &access_status);
-        NODE_exit_error(RADIO_ERROR_BASE_NODE);
-        // Check access status.
-        if ((access_status.flags) != 0) {
-            status = RADIO_ERROR_MODEL_UL_CONFIGURATION;
-            goto errors;
+        // Skip write if the modem already uses these settings.
+        if (reg_config_0 != radio_uhfm_ctx.config_0_nominal) {
+            reg_addr_list[reg_count] = UHFM_REGISTER_ADDRESS_CONFIGURATION_0;
+            reg_value_list[reg_count] = reg_config_0;
+            reg_mask_list[reg_count] = reg_config_0_mask;
+            reg_count++;
+            // Restore is required as soon as the settings write is issued, since its result may be unknown.
+            radio_uhfm_ctx.node_addr = (uhfm_node->address);
+            radio_uhfm_ctx.config_0_mask = reg_config_0_mask;
+            radio_uhfm_ctx.config_0_restore_pending = 1;
         }
     }
+    // Write payload and settings.
+    node_status = NODE_write_registers(uhfm_node, (uint8_t*) reg_addr_list, (uint32_t*) reg_value_list, (uint32_t*) reg_mask_list, reg_count, &access_status, &write_count);
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    // Check access status.
+    if ((access_status.flags) != 0) {
+        status = (write_count < payload_reg_count) ? RADIO_ERROR_MODEM_UL_PAYLOAD : RADIO_ERROR_MODEL_UL_CONFIGURATION;
+        goto errors;
+    }
     // Control register.
     SWREG_write_field(&reg_control_1, &reg_control_1_mask, (uint32_t) (ul_message->ul_payload_size), UHFM_REGISTER_CONTROL_1_MASK_SIGFOX_UL_PAYLOAD_SIZE);
     SWREG_write_field(&reg_control_1, &reg_control_1_mask, (uint32_t) (ul_message->bidirectional_flag), UHFM_REGISTER_CONTROL_1_MASK_SBF);
     SWREG_write_field(&reg_control_1, &reg_control_1_mask, (uint32_t) UHFM_UL_MESSAGE_TYPE_BYTE_ARRAY, UHFM_REGISTER_CONTROL_1_MASK_SIGFOX_MSGT);
     SWREG_write_field(&reg_control_1, &reg_control_1_mask, (uint32_t) 0b0, UHFM_REGISTER_CONTROL_1_MASK_SCMF);
     SWREG_write_field(&reg_control_1, &reg_control_1_mask, (uint32_t) 0b1, UHFM_REGISTER_CONTROL_1_MASK_STRG);
-    // Send message.
-    node_status = NODE_write_register(uhfm_node, UHFM_REGISTER_ADDRESS_CONTROL_1, reg_control_1, reg_control_1_mask, &access_status);
+    // Start transmission without waiting for its completion.
+    node_status = NODE_send_register(uhfm_node, UHFM_REGISTER_ADDRESS_CONTROL_1, reg_control_1, reg_control_1_mask, &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
     // Check access status.
     if ((access_status.flags) != 0) {
         status = RADIO_ERROR_MODEM_UL_TRANSMISSION;
         goto errors;
     }
+    // Update state.
+    radio_uhfm_ctx.state = RADIO_UHFM_STATE_TRANSMITTING;
+    radio_uhfm_ctx.poll_time_seconds = RTC_get_uptime_seconds();
+    radio_uhfm_ctx.timeout_time_seconds = radio_uhfm_ctx.poll_time_seconds;
+    radio_uhfm_ctx.poll_time_seconds += (((ul_message->bidirectional_flag) != 0) ? RADIO_UHFM_DL_DURATION_MIN_SECONDS : RADIO_UHFM_UL_DURATION_MIN_SECONDS);
+    radio_uhfm_ctx.timeout_time_seconds += (((ul_message->bidirectional_flag) != 0) ? RADIO_UHFM_DL_DURATION_MAX_SECONDS : RADIO_UHFM_UL_DURATION_MAX_SECONDS);
 errors:
-    if (((ul_message->bidirectional_flag) != 0) && (dump_valid != 0)) {
-        // Restore radio settings.
-        NODE_write_register(uhfm_node, UHFM_REGISTER_ADDRESS_CONFIGURATION_0, reg_config_0_initial, reg_config_0_mask, &access_status);
+    // Restore nominal settings if the transmission has not been started.
+    if ((uhfm_node != NULL) && (radio_uhfm_ctx.state != RADIO_UHFM_STATE_TRANSMITTING)) {
+        radio_status = _RADIO_UHFM_restore_configuration(uhfm_node);
+        RADIO_stack_error(ERROR_BASE_RADIO);
+    }
+    // Release bus interface.
+    if (session_opened != 0) {
+        NODE_close_session();
+    }
+    return status;
+}
+
+/*******************************************************************/
+RADIO_status_t RADIO_UHFM_wait_completion(UNA_node_t* uhfm_node) {
+    // Local variables.
+    RADIO_status_t status = RADIO_SUCCESS;
+    RADIO_status_t radio_status = RADIO_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    // Check parameter.
+    if (uhfm_node == NULL) {
+        status = RADIO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Poll modem until the end of the transmission.
+    while (1) {
+        status = _RADIO_UHFM_update_state(uhfm_node);
+        if ((status != RADIO_SUCCESS) || (radio_uhfm_ctx.state == RADIO_UHFM_STATE_IDLE)) break;
+        // Reload watchdog.
+        IWDG_reload();
+        // Wait in low power mode.
+        lptim_status = LPTIM_delay_milliseconds(RADIO_UHFM_POLL_PERIOD_MS, LPTIM_DELAY_MODE_STOP);
+        LPTIM_exit_error(RADIO_ERROR_BASE_LPTIM);
+    }
+    // Restore nominal settings after a bidirectional frame.
+    if (radio_uhfm_ctx.state == RADIO_UHFM_STATE_IDLE) {
+        radio_status = _RADIO_UHFM_restore_configuration(uhfm_node);
+        RADIO_stack_error(ERROR_BASE_RADIO);
     }
+errors:
     return status;
 }
 
 /*******************************************************************/
-RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payload_available, uint8_t* dl_payload) {
+RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payload_available, uint8_t* dl_payload, uint32_t* last_bidirectional_mc) {
     // Local variables.
     RADIO_status_t status = RADIO_SUCCESS;
     NODE_status_t node_status = NODE_SUCCESS;
@@ -208,14 +449,22 @@ RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payl
     uint32_t uhfm_registers[UHFM_REGISTER_ADDRESS_LAST];
     UHFM_ul_message_status_t message_status;
     uint8_t reg_addr = (UHFM_REGISTER_ADDRESS_SIGFOX_DL_PAYLOAD_0 - 1);
+    uint8_t session_opened = 0;
     uint8_t idx = 0;
     // Check parameters.
-    if ((uhfm_node == NULL) || (dl_payload_available == NULL) || (dl_payload == NULL)) {
+    if ((uhfm_node == NULL) || (dl_payload_available == NULL) || (dl_payload == NULL) || (last_bidirectional_mc == NULL)) {
         status = RADIO_ERROR_NULL_PARAMETER;
         goto errors;
     }
     // Reset output flag.
     (*dl_payload_available) = 0;
+    // Downlink payload is available at the end of the bidirectional sequence.
+    status = RADIO_UHFM_wait_completion(uhfm_node);
+    if (status != RADIO_SUCCESS) goto errors;
+    // Status and payload registers are read back-to-back.
+    node_status = NODE_open_session();
+    NODE_exit_error(RADIO_ERROR_BASE_NODE);
+    session_opened = 1;
     // Read message status.
     node_status = NODE_read_register(uhfm_node, UHFM_REGISTER_ADDRESS_STATUS_1, &(uhfm_registers[UHFM_REGISTER_ADDRESS_STATUS_1]), &access_status);
     NODE_exit_error(RADIO_ERROR_BASE_NODE);
@@ -224,8 +473,9 @@ RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payl
         status = RADIO_ERROR_MODEM_DL_MESSAGE_STATUS;
         goto errors;
     }
-    // Compute message status.
+    // Compute message status and counter.
     message_status.all = SWREG_read_field(uhfm_registers[UHFM_REGISTER_ADDRESS_STATUS_1], UHFM_REGISTER_STATUS_1_MASK_SIGFOX_MESSAGE_STATUS);
+    (*last_bidirectional_mc) = SWREG_read_field(uhfm_registers[UHFM_REGISTER_ADDRESS_STATUS_1], UHFM_REGISTER_STATUS_1_MASK_SIGFOX_BIDIRECTIONAL_MC);
     // Check DL flag.
     if (message_status.field.dl_frame == 0) goto errors;
     // Byte loop.
@@ -248,31 +498,9 @@ RADIO_status_t RADIO_UHFM_get_dl_payload(UNA_node_t* uhfm_node, uint8_t* dl_payl
     }
     (*dl_payload_available) = 1;
 errors:
-    return status;
-}
-
-/*******************************************************************/
-RADIO_status_t RADIO_UHFM_get_last_bidirectional_mc(UNA_node_t* uhfm_node, uint32_t* last_bidirectional_mc) {
-    // Local variables.
-    RADIO_status_t status = RADIO_SUCCESS;
-    NODE_status_t node_status = NODE_SUCCESS;
-    UNA_access_status_t access_status;
-    uint32_t reg_status_1 = 0;
-    // Check parameters.
-    if ((uhfm_node == NULL) || (last_bidirectional_mc == NULL)) {
-        status = RADIO_ERROR_NULL_PARAMETER;
-        goto errors;
+    // Release bus interface.
+    if (session_opened != 0) {
+        NODE_close_session();
     }
-    // Read message status.
-    node_status = NODE_read_register(uhfm_node, UHFM_REGISTER_ADDRESS_STATUS_1, &reg_status_1, &access_status);
-    NODE_exit_error(RADIO_ERROR_BASE_NODE);
-    // Check access status.
-    if ((access_status.flags) != 0) {
-        status = RADIO_ERROR_MODEM_DL_BIDIRECTIONAL_MC;
-        goto errors;
-    }
-    // Compute message counter.
-    (*last_bidirectional_mc) = SWREG_read_field(reg_status_1, UHFM_REGISTER_STATUS_1_MASK_SIGFOX_BIDIRECTIONAL_MC);
-errors:
     return status;
 }